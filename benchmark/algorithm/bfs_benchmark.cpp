@@ -0,0 +1,66 @@
+#include "gdwg/algorithm/bfs.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <limits>
+
+/*
+    Compares a top-down-only search, forced by making alpha tiny, with the direction-optimizing
+    default on a power-law graph, where bottom-up levels skip most edge checks, and on a grid,
+    where the frontier never grows large enough to switch. The argument is the thread count.
+*/
+
+namespace {
+	using gdwg::benchmark_inputs::csr;
+
+	void search(benchmark::State& state, csr const& g, double alpha) {
+		auto const transpose = g.transpose();
+		auto const options =
+		   gdwg::bfs_options{.threads = static_cast<unsigned>(state.range(0)), .alpha = alpha};
+		auto source = std::uint32_t{0};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::bfs(g, transpose, source, options));
+			source = (source + 7919) % g.node_count();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+	}
+
+	void top_down_power_law(benchmark::State& state) {
+		search(state, gdwg::benchmark_inputs::power_law_csr(), std::numeric_limits<double>::min());
+	}
+
+	void direction_optimizing_power_law(benchmark::State& state) {
+		search(state, gdwg::benchmark_inputs::power_law_csr(), gdwg::bfs_options().alpha);
+	}
+
+	void top_down_grid(benchmark::State& state) {
+		search(state, gdwg::benchmark_inputs::grid_csr(), std::numeric_limits<double>::min());
+	}
+
+	void direction_optimizing_grid(benchmark::State& state) {
+		search(state, gdwg::benchmark_inputs::grid_csr(), gdwg::bfs_options().alpha);
+	}
+} // namespace
+
+BENCHMARK(top_down_power_law)
+   ->Arg(1)
+   ->Arg(4)
+   ->Apply(gdwg::benchmark_inputs::wall_time)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(direction_optimizing_power_law)
+   ->Arg(1)
+   ->Arg(4)
+   ->Apply(gdwg::benchmark_inputs::wall_time)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(top_down_grid)
+   ->Arg(1)
+   ->Arg(4)
+   ->Apply(gdwg::benchmark_inputs::wall_time)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(direction_optimizing_grid)
+   ->Arg(1)
+   ->Arg(4)
+   ->Apply(gdwg::benchmark_inputs::wall_time)
+   ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,75 @@
+#include "gdwg/algorithm/delta_stepping.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+/*
+    Delta-stepping on the road-like grid and the power-law graph for 1 to 8 threads, against
+    sequential Dijkstra with a radix heap as the baseline to beat, and across bucket widths on
+    the grid with one thread to show the cost of re-relaxing nodes in wide buckets.
+*/
+
+namespace {
+	using gdwg::benchmark_inputs::csr;
+
+	void delta_stepping(benchmark::State& state, csr const& g, std::uint32_t delta) {
+		auto const options = gdwg::delta_stepping_options<std::uint32_t>{
+		   .delta = delta,
+		   .threads = static_cast<unsigned>(state.range(0)),
+		};
+		auto source = std::uint32_t{0};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::delta_stepping(g, source, options));
+			source = (source + 7919) % g.node_count();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+	}
+
+	void dijkstra(benchmark::State& state, csr const& g) {
+		auto source = std::uint32_t{0};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::dijkstra<gdwg::radix_heap>(g, source));
+			source = (source + 7919) % g.node_count();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+	}
+
+	void delta_stepping_grid(benchmark::State& state) {
+		delta_stepping(state, gdwg::benchmark_inputs::grid_csr(), 0);
+	}
+
+	void delta_stepping_power_law(benchmark::State& state) {
+		delta_stepping(state, gdwg::benchmark_inputs::power_law_csr(), 0);
+	}
+
+	void delta_stepping_grid_width(benchmark::State& state) {
+		auto const delta = static_cast<std::uint32_t>(state.range(1));
+		delta_stepping(state, gdwg::benchmark_inputs::grid_csr(), delta);
+	}
+
+	void dijkstra_grid(benchmark::State& state) {
+		dijkstra(state, gdwg::benchmark_inputs::grid_csr());
+	}
+
+	void dijkstra_power_law(benchmark::State& state) {
+		dijkstra(state, gdwg::benchmark_inputs::power_law_csr());
+	}
+} // namespace
+
+BENCHMARK(delta_stepping_grid)
+   ->RangeMultiplier(2)
+   ->Range(1, 8)
+   ->Apply(gdwg::benchmark_inputs::wall_time)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(delta_stepping_power_law)
+   ->RangeMultiplier(2)
+   ->Range(1, 8)
+   ->Apply(gdwg::benchmark_inputs::wall_time)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(delta_stepping_grid_width)
+   ->ArgsProduct({{1}, {16, 64, 256, 1024, 4096}})
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(dijkstra_grid)->Unit(benchmark::kMillisecond);
+BENCHMARK(dijkstra_power_law)->Unit(benchmark::kMillisecond);
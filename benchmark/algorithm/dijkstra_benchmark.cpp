@@ -0,0 +1,73 @@
+#include "gdwg/algorithm/dijkstra.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+/*
+    Full single-source searches with each queue on a power-law graph and a grid, then
+    point-to-point queries between nearby grid nodes with a search object reused across queries
+    against one built per query, which has to allocate and fill arrays for the whole graph.
+*/
+
+namespace {
+	using gdwg::benchmark_inputs::csr;
+
+	template<template<typename, typename> typename Queue>
+	void single_source(benchmark::State& state, csr const& g) {
+		auto search = gdwg::dijkstra_search<std::uint32_t, std::uint32_t, Queue>(g);
+		auto source = std::uint32_t{0};
+		for (auto _ : state) {
+			search.run(source);
+			benchmark::DoNotOptimize(search.distance(0));
+			source = (source + 7919) % g.node_count();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+	}
+
+	template<template<typename, typename> typename Queue>
+	void single_source_power_law(benchmark::State& state) {
+		single_source<Queue>(state, gdwg::benchmark_inputs::power_law_csr());
+	}
+
+	template<template<typename, typename> typename Queue>
+	void single_source_grid(benchmark::State& state) {
+		single_source<Queue>(state, gdwg::benchmark_inputs::grid_csr());
+	}
+
+	// Queries from a node to one two rows below and two columns right of it in the 512 x 512
+	// grid, like routing between nearby addresses.
+	auto query_target(std::uint32_t source, csr const& g) -> std::uint32_t {
+		return (source + 2 * 512 + 2) % g.node_count();
+	}
+
+	void point_to_point_reused(benchmark::State& state) {
+		auto const& g = gdwg::benchmark_inputs::grid_csr();
+		auto search = gdwg::dijkstra_search<std::uint32_t, std::uint32_t, gdwg::radix_heap>(g);
+		auto source = std::uint32_t{0};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(search.run(source, query_target(source, g)));
+			source = (source + 7919) % g.node_count();
+		}
+	}
+
+	void point_to_point_fresh(benchmark::State& state) {
+		auto const& g = gdwg::benchmark_inputs::grid_csr();
+		auto source = std::uint32_t{0};
+		for (auto _ : state) {
+			auto search = gdwg::dijkstra_search<std::uint32_t, std::uint32_t, gdwg::radix_heap>(g);
+			benchmark::DoNotOptimize(search.run(source, query_target(source, g)));
+			source = (source + 7919) % g.node_count();
+		}
+	}
+} // namespace
+
+BENCHMARK(single_source_power_law<gdwg::binary_heap>)->Unit(benchmark::kMillisecond);
+BENCHMARK(single_source_power_law<gdwg::quaternary_heap>)->Unit(benchmark::kMillisecond);
+BENCHMARK(single_source_power_law<gdwg::radix_heap>)->Unit(benchmark::kMillisecond);
+BENCHMARK(single_source_grid<gdwg::binary_heap>)->Unit(benchmark::kMillisecond);
+BENCHMARK(single_source_grid<gdwg::quaternary_heap>)->Unit(benchmark::kMillisecond);
+BENCHMARK(single_source_grid<gdwg::radix_heap>)->Unit(benchmark::kMillisecond);
+BENCHMARK(point_to_point_reused)->Unit(benchmark::kMicrosecond);
+BENCHMARK(point_to_point_fresh)->Unit(benchmark::kMicrosecond);
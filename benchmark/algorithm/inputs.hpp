@@ -0,0 +1,54 @@
+#ifndef GDWG_BENCHMARK_ALGORITHM_INPUTS_HPP
+#define GDWG_BENCHMARK_ALGORITHM_INPUTS_HPP
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace gdwg::benchmark_inputs {
+	using csr = gdwg::csr_graph<std::uint32_t, std::uint32_t>;
+
+	// For ->Apply on the benchmarks of the parallel algorithms. They are timed by wall time, as
+	// the CPU time Google Benchmark reports by default doesn't count the worker threads'.
+	inline auto wall_time(::benchmark::internal::Benchmark* b) -> void {
+		b->UseRealTime();
+	}
+
+	// Low diameter and skewed degrees, like social and web graphs.
+	inline auto power_law_csr() -> csr const& {
+		static auto const g = csr::from_generator(gdwg::rmat_generator(18, 1 << 22, 6771));
+		return g;
+	}
+
+	// The power-law graph with every edge pointing from its lower id to its higher, like a
+	// dependency graph whose hubs are depended on by everything.
+	inline auto power_law_dag_csr() -> csr const& {
+		static auto const g = [] {
+			auto edges = std::vector<gdwg::generated_edge>();
+			for (auto edge : gdwg::rmat_generator(18, 1 << 22, 6771)) {
+				if (edge.src != edge.dst) {
+					auto const [low, high] = std::minmax(edge.src, edge.dst);
+					edges.push_back({low, high, edge.weight});
+				}
+			}
+			auto nodes = std::vector<std::uint32_t>(1 << 18);
+			for (auto i = std::size_t{0}; i < nodes.size(); ++i) {
+				nodes[i] = static_cast<std::uint32_t>(i);
+			}
+			return csr(std::move(nodes), edges.begin(), edges.end());
+		}();
+		return g;
+	}
+
+	// High diameter and uniform degree, like road networks.
+	inline auto grid_csr() -> csr const& {
+		static auto const g = csr::from_generator(gdwg::grid_generator(512, 512, 6771));
+		return g;
+	}
+} // namespace gdwg::benchmark_inputs
+
+#endif // GDWG_BENCHMARK_ALGORITHM_INPUTS_HPP
@@ -0,0 +1,47 @@
+#include "gdwg/algorithm/pagerank.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+/*
+    Twenty PageRank iterations on the power-law graph, unweighted and weighted, for 1 to 8
+    threads. Items are edges pulled, so the rate reads directly as the kernel's throughput.
+*/
+
+namespace {
+	void iterations(benchmark::State& state, bool weighted) {
+		auto const& g = gdwg::benchmark_inputs::power_law_csr();
+		auto const transpose = g.transpose();
+		auto const options = gdwg::pagerank_options{
+		   .tolerance = 0,
+		   .max_iterations = 20,
+		   .weighted = weighted,
+		   .threads = static_cast<unsigned>(state.range(0)),
+		};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::pagerank(g, transpose, options));
+		}
+		state.SetItemsProcessed(state.iterations() * 20 * static_cast<std::int64_t>(g.edge_count()));
+	}
+
+	void unweighted(benchmark::State& state) {
+		iterations(state, false);
+	}
+
+	void weighted(benchmark::State& state) {
+		iterations(state, true);
+	}
+} // namespace
+
+BENCHMARK(unweighted)
+   ->RangeMultiplier(2)
+   ->Range(1, 8)
+   ->Apply(gdwg::benchmark_inputs::wall_time)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(weighted)
+   ->RangeMultiplier(2)
+   ->Range(1, 8)
+   ->Apply(gdwg::benchmark_inputs::wall_time)
+   ->Unit(benchmark::kMillisecond);
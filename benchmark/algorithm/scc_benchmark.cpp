@@ -0,0 +1,61 @@
+#include "gdwg/algorithm/scc.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+/*
+    Tarjan's algorithm against the parallel trim, forward-backward and colouring search for 1 to
+    8 threads. The power-law graph has one giant component among many trivial ones, like a
+    dependency graph; the grid is a single component with a large diameter.
+*/
+
+namespace {
+	using gdwg::benchmark_inputs::csr;
+
+	void tarjan(benchmark::State& state, csr const& g) {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::tarjan_scc(g));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+	}
+
+	void parallel(benchmark::State& state, csr const& g) {
+		auto const transpose = g.transpose();
+		auto const options = gdwg::scc_options{static_cast<unsigned>(state.range(0))};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::parallel_scc(g, transpose, options));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+	}
+
+	void tarjan_power_law(benchmark::State& state) {
+		tarjan(state, gdwg::benchmark_inputs::power_law_csr());
+	}
+
+	void tarjan_grid(benchmark::State& state) {
+		tarjan(state, gdwg::benchmark_inputs::grid_csr());
+	}
+
+	void parallel_power_law(benchmark::State& state) {
+		parallel(state, gdwg::benchmark_inputs::power_law_csr());
+	}
+
+	void parallel_grid(benchmark::State& state) {
+		parallel(state, gdwg::benchmark_inputs::grid_csr());
+	}
+} // namespace
+
+BENCHMARK(tarjan_power_law)->Unit(benchmark::kMillisecond);
+BENCHMARK(tarjan_grid)->Unit(benchmark::kMillisecond);
+BENCHMARK(parallel_power_law)
+   ->RangeMultiplier(2)
+   ->Range(1, 8)
+   ->Apply(gdwg::benchmark_inputs::wall_time)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(parallel_grid)
+   ->RangeMultiplier(2)
+   ->Range(1, 8)
+   ->Apply(gdwg::benchmark_inputs::wall_time)
+   ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,47 @@
+#include "gdwg/algorithm/topological_sort.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+/*
+    Level-by-level Kahn sorting for 1 to 8 threads, and the cycle search. On the acyclic
+    power-law graph the cycle search has to visit every edge to prove there is no cycle; on the
+    original graph it stops at the first cycle it meets, which is the case early exit is for.
+*/
+
+namespace {
+	void sort_power_law_dag(benchmark::State& state) {
+		auto const& g = gdwg::benchmark_inputs::power_law_dag_csr();
+		auto const options = gdwg::topological_sort_options{static_cast<unsigned>(state.range(0))};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::topological_sort(g, options));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+	}
+
+	void find_cycle_power_law_dag(benchmark::State& state) {
+		auto const& g = gdwg::benchmark_inputs::power_law_dag_csr();
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::find_cycle(g));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+	}
+
+	// no items: how much of the graph the search sees before it stops is the point
+	void find_cycle_power_law(benchmark::State& state) {
+		auto const& g = gdwg::benchmark_inputs::power_law_csr();
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::find_cycle(g));
+		}
+	}
+} // namespace
+
+BENCHMARK(sort_power_law_dag)
+   ->RangeMultiplier(2)
+   ->Range(1, 8)
+   ->Apply(gdwg::benchmark_inputs::wall_time)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(find_cycle_power_law_dag)->Unit(benchmark::kMillisecond);
+BENCHMARK(find_cycle_power_law)->Unit(benchmark::kMicrosecond);
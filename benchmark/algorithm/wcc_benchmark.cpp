@@ -0,0 +1,86 @@
+#include "gdwg/algorithm/wcc.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+/*
+    Afforest against plain concurrent union-find over every edge (no neighbour rounds, so no
+    component is skipped) for 1 to 8 threads, and incremental_components answering
+    connectivity queries while a graph grows, against recomputing the components per query.
+*/
+
+namespace {
+	using gdwg::benchmark_inputs::csr;
+
+	void components(benchmark::State& state, std::uint32_t rounds) {
+		auto const& g = gdwg::benchmark_inputs::power_law_csr();
+		auto const transpose = g.transpose();
+		auto const options = gdwg::wcc_options{static_cast<unsigned>(state.range(0)), rounds};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::weakly_connected_components(g, transpose, options));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+	}
+
+	void afforest(benchmark::State& state) {
+		components(state, gdwg::wcc_options().neighbour_rounds);
+	}
+
+	void union_find(benchmark::State& state) {
+		components(state, 0);
+	}
+
+	// Inserts state.range(0) generated edges into a 4096 node graph, asking whether two nodes
+	// are connected after each.
+	void incremental_queries(benchmark::State& state) {
+		auto const generator =
+		   gdwg::erdos_renyi_generator(4096, static_cast<std::uint64_t>(state.range(0)), 1);
+		for (auto _ : state) {
+			auto c = gdwg::incremental_components<std::uint64_t, gdwg::hashed_storage>();
+			for (auto v = std::uint64_t{0}; v < 4096; ++v) {
+				c.insert_node(v);
+			}
+			auto connected = 0;
+			for (auto const& [src, dst, weight] : generator) {
+				c.insert_edge(src, dst);
+				connected += c.connected(src / 2, dst / 2) ? 1 : 0;
+			}
+			benchmark::DoNotOptimize(connected);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void recomputed_queries(benchmark::State& state) {
+		auto const generator =
+		   gdwg::erdos_renyi_generator(4096, static_cast<std::uint64_t>(state.range(0)), 1);
+		for (auto _ : state) {
+			auto g = gdwg::graph<std::uint64_t, std::uint32_t>();
+			for (auto v = std::uint64_t{0}; v < 4096; ++v) {
+				g.insert_node(v);
+			}
+			auto connected = 0;
+			for (auto const& [src, dst, weight] : generator) {
+				g.insert_edge(src, dst, weight);
+				auto const result = gdwg::weakly_connected_components(g, {1});
+				connected += result.component[src / 2] == result.component[dst / 2] ? 1 : 0;
+			}
+			benchmark::DoNotOptimize(connected);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+} // namespace
+
+BENCHMARK(afforest)
+   ->RangeMultiplier(2)
+   ->Range(1, 8)
+   ->Apply(gdwg::benchmark_inputs::wall_time)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(union_find)
+   ->RangeMultiplier(2)
+   ->Range(1, 8)
+   ->Apply(gdwg::benchmark_inputs::wall_time)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(incremental_queries)->Arg(1 << 10)->Arg(1 << 14)->Unit(benchmark::kMillisecond);
+BENCHMARK(recomputed_queries)->Arg(1 << 10)->Unit(benchmark::kMillisecond);
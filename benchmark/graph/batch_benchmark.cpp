@@ -0,0 +1,84 @@
+#include "gdwg/graph.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+/*
+    Measures applying a change set of interleaved inserts and erases to a power-law graph, one
+    call at a time against a single mutation_batch, with std::set and sorted vector edge sets.
+    Half the changes erase existing edges and half insert new ones, and most of them touch the
+    hub nodes' edge sets.
+*/
+
+namespace {
+	constexpr auto nodes = 1 << 12;
+	constexpr auto base_edges = 1 << 18;
+
+	template<typename Storage, typename Apply>
+	void apply_changes(benchmark::State& state, Apply apply) {
+		auto const changes = static_cast<int>(state.range(0));
+		auto const edges = gdwg::benchmark::power_law_edges(nodes, base_edges + changes / 2);
+		auto base = gdwg::graph<int, int, Storage>();
+		for (auto i = 0; i < nodes; ++i) {
+			base.insert_node(i);
+		}
+		for (auto i = 0; i < base_edges; ++i) {
+			auto const& [src, dst, weight] = edges[static_cast<std::size_t>(i)];
+			base.insert_edge(src, dst, weight);
+		}
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto g = base;
+			state.ResumeTiming();
+			apply(g, edges, changes);
+		}
+		state.SetItemsProcessed(state.iterations() * changes);
+	}
+
+	template<typename Storage>
+	void single_calls(benchmark::State& state) {
+		apply_changes<Storage>(state, [](auto& g, auto const& edges, int changes) {
+			for (auto i = 0; i < changes / 2; ++i) {
+				auto const& [src, dst, weight] = edges[static_cast<std::size_t>(i)];
+				benchmark::DoNotOptimize(g.erase_edge(src, dst, weight));
+				auto const& [new_src, new_dst, new_weight] =
+				   edges[static_cast<std::size_t>(base_edges + i)];
+				benchmark::DoNotOptimize(g.insert_edge(new_src, new_dst, new_weight));
+			}
+		});
+	}
+
+	template<typename Storage>
+	void mutation_batch(benchmark::State& state) {
+		apply_changes<Storage>(state, [](auto& g, auto const& edges, int changes) {
+			auto batch = g.batch();
+			for (auto i = 0; i < changes / 2; ++i) {
+				auto const& [src, dst, weight] = edges[static_cast<std::size_t>(i)];
+				batch.erase_edge(src, dst, weight);
+				auto const& [new_src, new_dst, new_weight] =
+				   edges[static_cast<std::size_t>(base_edges + i)];
+				batch.insert_edge(new_src, new_dst, new_weight);
+			}
+			benchmark::DoNotOptimize(batch.commit());
+		});
+	}
+} // namespace
+
+BENCHMARK_TEMPLATE(single_calls, gdwg::ordered_storage)
+   ->Arg(1 << 12)
+   ->Arg(1 << 17)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(mutation_batch, gdwg::ordered_storage)
+   ->Arg(1 << 12)
+   ->Arg(1 << 17)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(single_calls, gdwg::flat_storage)
+   ->Arg(1 << 12)
+   ->Arg(1 << 17)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(mutation_batch, gdwg::flat_storage)
+   ->Arg(1 << 12)
+   ->Arg(1 << 17)
+   ->Unit(benchmark::kMillisecond);
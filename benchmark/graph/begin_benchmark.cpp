@@ -0,0 +1,51 @@
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+
+/*
+    Measures begin() and draining a graph through erase_edge(begin()) when almost every node is
+    isolated and the nodes with edges come last in the node order. This is the shape where
+    finding the first edge by walking the node table used to cost O(number of nodes).
+*/
+
+namespace {
+	constexpr auto sources = 64;
+
+	auto mostly_isolated(int isolated) -> gdwg::graph<int, int> {
+		auto g = gdwg::graph<int, int>();
+		for (auto i = 0; i < isolated + sources; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = isolated; i < isolated + sources; ++i) {
+			g.insert_edge(i, 0, 1);
+		}
+		return g;
+	}
+
+	void begin_mostly_isolated(benchmark::State& state) {
+		auto const g = mostly_isolated(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.begin());
+		}
+	}
+
+	void erase_begin_mostly_isolated(benchmark::State& state) {
+		auto const isolated = static_cast<int>(state.range(0));
+		auto g = mostly_isolated(isolated);
+		for (auto _ : state) {
+			while (g.begin() != g.end()) {
+				g.erase_edge(g.begin());
+			}
+			// put the edges back untimed so every iteration drains the same graph
+			state.PauseTiming();
+			for (auto i = isolated; i < isolated + sources; ++i) {
+				g.insert_edge(i, 0, 1);
+			}
+			state.ResumeTiming();
+		}
+		state.SetItemsProcessed(state.iterations() * sources);
+	}
+} // namespace
+
+BENCHMARK(begin_mostly_isolated)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(erase_begin_mostly_isolated)->Arg(1 << 10)->Arg(1 << 20);
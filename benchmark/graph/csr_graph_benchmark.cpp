@@ -0,0 +1,61 @@
+#include "gdwg/csr_graph.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+/*
+    Compares read-only traversal of a graph against its csr_graph snapshot: a full edge
+    iteration, and a stream of is_connected queries between random node pairs.
+*/
+
+namespace {
+	template<typename Graph>
+	void iterate(benchmark::State& state, Graph const& g) {
+		for (auto _ : state) {
+			auto total = 0L;
+			for (auto const& [from, to, weight] : g) {
+				total += weight;
+			}
+			benchmark::DoNotOptimize(total);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(1));
+	}
+
+	template<typename Graph>
+	void query(benchmark::State& state, Graph const& g) {
+		auto const nodes = static_cast<int>(state.range(0));
+		auto rng = std::mt19937(6771);
+		auto node = std::uniform_int_distribution<int>(0, nodes - 1);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.is_connected(node(rng), node(rng)));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	void graph_iterate(benchmark::State& state) {
+		iterate(state,
+		        gdwg::benchmark::power_law_graph(static_cast<int>(state.range(0)),
+		                                         static_cast<int>(state.range(1))));
+	}
+	void csr_graph_iterate(benchmark::State& state) {
+		iterate(state,
+		        gdwg::csr_graph(gdwg::benchmark::power_law_graph(static_cast<int>(state.range(0)),
+		                                                         static_cast<int>(state.range(1)))));
+	}
+	void graph_is_connected(benchmark::State& state) {
+		query(state,
+		      gdwg::benchmark::power_law_graph(static_cast<int>(state.range(0)),
+		                                       static_cast<int>(state.range(1))));
+	}
+	void csr_graph_is_connected(benchmark::State& state) {
+		query(state,
+		      gdwg::csr_graph(gdwg::benchmark::power_law_graph(static_cast<int>(state.range(0)),
+		                                                       static_cast<int>(state.range(1)))));
+	}
+} // namespace
+
+BENCHMARK(graph_iterate)->Args({1 << 12, 1 << 16})->Args({1 << 14, 1 << 18});
+BENCHMARK(csr_graph_iterate)->Args({1 << 12, 1 << 16})->Args({1 << 14, 1 << 18});
+BENCHMARK(graph_is_connected)->Args({1 << 12, 1 << 16})->Args({1 << 14, 1 << 18});
+BENCHMARK(csr_graph_is_connected)->Args({1 << 12, 1 << 16})->Args({1 << 14, 1 << 18});
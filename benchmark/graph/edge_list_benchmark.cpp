@@ -0,0 +1,86 @@
+#include "gdwg/edge_list.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <span>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+/*
+    Parsing a tab separated edge list held in memory, so the numbers are the parser's and not
+    the disk's: reading a token at a time with istream >> as a baseline, read_edge_list on one
+    thread and on all of them, and loading the edges into a graph. Bytes and items processed
+    give the MB/s and edges/s that read_edge_list reports in its stats.
+*/
+
+namespace {
+	auto edge_list_text(benchmark::State const& state) -> std::string {
+		auto text = std::string();
+		for (auto const& [src, dst, weight] :
+		     gdwg::benchmark::power_law_edges(1 << 16, static_cast<int>(state.range(0))))
+		{
+			text += std::to_string(src) + '\t' + std::to_string(dst) + '\t'
+			        + std::to_string(weight) + '\n';
+		}
+		return text;
+	}
+
+	auto set_processed(benchmark::State& state, std::string const& text) -> void {
+		state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void stream_extraction(benchmark::State& state) {
+		auto const text = edge_list_text(state);
+		for (auto _ : state) {
+			auto in = std::istringstream(text);
+			auto edges = gdwg::benchmark::edge_list();
+			auto src = 0;
+			auto dst = 0;
+			auto weight = 0;
+			while (in >> src >> dst >> weight) {
+				edges.emplace_back(src, dst, weight);
+			}
+			benchmark::DoNotOptimize(edges.data());
+		}
+		set_processed(state, text);
+	}
+
+	void read_edge_list(benchmark::State& state) {
+		auto const text = edge_list_text(state);
+		auto const threads = static_cast<unsigned>(state.range(1));
+		for (auto _ : state) {
+			auto in = std::istringstream(text);
+			auto edges = std::size_t{0};
+			gdwg::read_edge_list<int, int>(
+			   in,
+			   [&edges](std::span<std::tuple<int, int, int> const> batch) { edges += batch.size(); },
+			   {.threads = threads});
+			benchmark::DoNotOptimize(edges);
+		}
+		set_processed(state, text);
+	}
+
+	void load_edge_list(benchmark::State& state) {
+		auto const text = edge_list_text(state);
+		for (auto _ : state) {
+			auto in = std::istringstream(text);
+			auto g = gdwg::graph<int, int>();
+			gdwg::load_edge_list(g, in);
+			benchmark::DoNotOptimize(g.empty());
+		}
+		set_processed(state, text);
+	}
+} // namespace
+
+BENCHMARK(stream_extraction)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(read_edge_list)
+   ->ArgNames({"edges", "threads"})
+   ->Args({1 << 16, 1})
+   ->Args({1 << 20, 1})
+   ->Args({1 << 20, 0})
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(load_edge_list)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
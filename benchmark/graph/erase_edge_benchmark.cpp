@@ -0,0 +1,58 @@
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+/*
+    Measures erase_edge(src, dst, weight) on a hub node whose degree is the benchmark argument.
+    Each iteration erases a fixed number of the hub's edges and puts them back untimed, so the
+    degree stays the same throughout. The cost should grow with log(degree) for std::set edge
+    sets rather than with the degree itself.
+*/
+
+namespace {
+	constexpr auto erased_per_iteration = 256;
+
+	template<typename Storage>
+	void erase_edge_high_degree(benchmark::State& state) {
+		auto const degree = static_cast<int>(state.range(0));
+		auto g = gdwg::graph<int, int, Storage>();
+		for (auto i = 0; i <= degree; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 1; i <= degree; ++i) {
+			g.insert_edge(0, i, i % 7);
+		}
+		auto rng = std::mt19937(6771);
+		auto dst = std::uniform_int_distribution<int>(1, degree);
+		auto victims = std::vector<int>();
+		for (auto _ : state) {
+			state.PauseTiming();
+			victims.clear();
+			for (auto i = 0; i < erased_per_iteration; ++i) {
+				victims.push_back(dst(rng));
+			}
+			state.ResumeTiming();
+			for (auto const victim : victims) {
+				benchmark::DoNotOptimize(g.erase_edge(0, victim, victim % 7));
+			}
+			state.PauseTiming();
+			for (auto const victim : victims) {
+				g.insert_edge(0, victim, victim % 7);
+			}
+			state.ResumeTiming();
+		}
+		state.SetItemsProcessed(state.iterations() * erased_per_iteration);
+	}
+} // namespace
+
+BENCHMARK_TEMPLATE(erase_edge_high_degree, gdwg::ordered_storage)
+   ->Arg(1 << 10)
+   ->Arg(1 << 14)
+   ->Arg(1 << 17);
+BENCHMARK_TEMPLATE(erase_edge_high_degree, gdwg::flat_storage)
+   ->Arg(1 << 10)
+   ->Arg(1 << 14)
+   ->Arg(1 << 17);
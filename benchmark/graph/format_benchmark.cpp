@@ -0,0 +1,98 @@
+#include "gdwg/format.hpp"
+#include "graph/endl_per_line.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+/*
+    Dumping a power-law graph to a file: the old operator<<, which ended every line with
+    std::endl and so flushed the file once per line, against the buffered operator<< and, where
+    fmt is found, fmt::format into a string. Also reading a dump back from a file with
+    operator>>. Bytes processed gives the dump and reload rates.
+*/
+
+namespace {
+	auto dump_path() -> std::filesystem::path {
+		return std::filesystem::temp_directory_path() / "gdwg_format_benchmark";
+	}
+
+	auto dump_size(gdwg::graph<int, int> const& g) -> std::int64_t {
+		auto out = std::ostringstream();
+		out << g;
+		return static_cast<std::int64_t>(out.str().size());
+	}
+
+	template<typename Dump>
+	void dump_to_file(benchmark::State& state, Dump dump) {
+		auto const g = gdwg::benchmark::power_law_graph(static_cast<int>(state.range(0)),
+		                                                static_cast<int>(state.range(1)));
+		for (auto _ : state) {
+			auto out = std::ofstream(dump_path());
+			dump(out, g);
+		}
+		state.SetBytesProcessed(state.iterations() * dump_size(g));
+		state.SetItemsProcessed(state.iterations() * state.range(1));
+		std::filesystem::remove(dump_path());
+	}
+
+	void endl_per_line(benchmark::State& state) {
+		dump_to_file(state, [](std::ostream& os, auto const& g) { gdwg::test::endl_per_line(os, g); });
+	}
+
+	void buffered_extractor(benchmark::State& state) {
+		dump_to_file(state, [](std::ostream& os, auto const& g) { os << g; });
+	}
+
+#if defined(GDWG_WITH_FMT)
+	void fmt_format(benchmark::State& state) {
+		auto const g = gdwg::benchmark::power_law_graph(static_cast<int>(state.range(0)),
+		                                                static_cast<int>(state.range(1)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(fmt::format("{}", g));
+		}
+		state.SetBytesProcessed(state.iterations() * dump_size(g));
+		state.SetItemsProcessed(state.iterations() * state.range(1));
+	}
+#endif
+
+	void reload_from_file(benchmark::State& state) {
+		auto const g = gdwg::benchmark::power_law_graph(static_cast<int>(state.range(0)),
+		                                                static_cast<int>(state.range(1)));
+		std::ofstream(dump_path()) << g;
+		for (auto _ : state) {
+			auto in = std::ifstream(dump_path());
+			auto read = gdwg::graph<int, int>();
+			in >> read;
+			benchmark::DoNotOptimize(read.empty());
+		}
+		state.SetBytesProcessed(state.iterations() * dump_size(g));
+		state.SetItemsProcessed(state.iterations() * state.range(1));
+		std::filesystem::remove(dump_path());
+	}
+} // namespace
+
+BENCHMARK(endl_per_line)
+   ->Args({1 << 12, 1 << 16})
+   ->Args({1 << 16, 1 << 20})
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(buffered_extractor)
+   ->Args({1 << 12, 1 << 16})
+   ->Args({1 << 16, 1 << 20})
+   ->Unit(benchmark::kMillisecond);
+#if defined(GDWG_WITH_FMT)
+BENCHMARK(fmt_format)
+   ->Args({1 << 12, 1 << 16})
+   ->Args({1 << 16, 1 << 20})
+   ->Unit(benchmark::kMillisecond);
+#endif
+BENCHMARK(reload_from_file)
+   ->Args({1 << 12, 1 << 16})
+   ->Args({1 << 16, 1 << 20})
+   ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,64 @@
+#include "gdwg/generators.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+/*
+    Measures how fast each generator streams edges, which should stay well ahead of anything
+    that consumes them, and loading a generated graph through insert_generated.
+*/
+
+namespace {
+	template<typename Generator>
+	void stream(benchmark::State& state, Generator const& generator) {
+		for (auto _ : state) {
+			auto total = std::uint64_t{0};
+			for (auto const& [src, dst, weight] : generator) {
+				total += src ^ dst ^ weight;
+			}
+			benchmark::DoNotOptimize(total);
+		}
+		state.SetItemsProcessed(state.iterations()
+		                        * static_cast<std::int64_t>(generator.edge_count()));
+	}
+
+	void stream_rmat(benchmark::State& state) {
+		stream(state, gdwg::rmat_generator(20, static_cast<std::uint64_t>(state.range(0)), 1));
+	}
+
+	void stream_erdos_renyi(benchmark::State& state) {
+		stream(state,
+		       gdwg::erdos_renyi_generator(1 << 20, static_cast<std::uint64_t>(state.range(0)), 1));
+	}
+
+	void stream_barabasi_albert(benchmark::State& state) {
+		auto const nodes = static_cast<std::uint64_t>(state.range(0)) / 16;
+		stream(state, gdwg::barabasi_albert_generator(nodes, 16, 1));
+	}
+
+	void stream_grid(benchmark::State& state) {
+		// a square grid with about state.range(0) edges
+		auto side = std::uint64_t{1};
+		while (4 * side * side < static_cast<std::uint64_t>(state.range(0))) {
+			side *= 2;
+		}
+		stream(state, gdwg::grid_generator(side, side, 1));
+	}
+
+	void insert_generated_rmat(benchmark::State& state) {
+		auto const generator =
+		   gdwg::rmat_generator(16, static_cast<std::uint64_t>(state.range(0)), 1);
+		for (auto _ : state) {
+			auto g = gdwg::graph<int, int>();
+			benchmark::DoNotOptimize(gdwg::insert_generated(g, generator));
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+} // namespace
+
+BENCHMARK(stream_rmat)->Arg(1 << 24)->Unit(benchmark::kMillisecond);
+BENCHMARK(stream_erdos_renyi)->Arg(1 << 24)->Unit(benchmark::kMillisecond);
+BENCHMARK(stream_barabasi_albert)->Arg(1 << 24)->Unit(benchmark::kMillisecond);
+BENCHMARK(stream_grid)->Arg(1 << 24)->Unit(benchmark::kMillisecond);
+BENCHMARK(insert_generated_rmat)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
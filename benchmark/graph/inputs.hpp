@@ -0,0 +1,84 @@
+#ifndef GDWG_BENCHMARK_INPUTS_HPP
+#define GDWG_BENCHMARK_INPUTS_HPP
+#include "gdwg/generators.hpp"
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace gdwg::benchmark {
+	using edge_list = std::vector<std::tuple<int, int, int>>;
+
+	template<typename Generator>
+	auto edges_of(Generator const& generator) -> edge_list {
+		auto result = edge_list();
+		result.reserve(static_cast<std::size_t>(generator.edge_count()));
+		for (auto const& [src, dst, weight] : generator) {
+			result.emplace_back(static_cast<int>(src),
+			                    static_cast<int>(dst),
+			                    static_cast<int>(weight));
+		}
+		return result;
+	}
+
+	// R-MAT edges over the nodes [0, nodes), where nodes is a power of two. A handful of hub
+	// nodes have most of the edges. The same arguments always give the same edges.
+	inline auto power_law_edges(int nodes, int edges) -> edge_list {
+		auto const scale = static_cast<unsigned>(std::bit_width(static_cast<unsigned>(nodes)) - 1);
+		return edges_of(gdwg::rmat_generator(scale, static_cast<std::uint64_t>(edges), 6771));
+	}
+
+	// Edges over the nodes [0, nodes) with both endpoints chosen uniformly, so every node has
+	// about the same degree.
+	inline auto uniform_edges(int nodes, int edges) -> edge_list {
+		return edges_of(gdwg::erdos_renyi_generator(static_cast<std::uint64_t>(nodes),
+		                                            static_cast<std::uint64_t>(edges),
+		                                            6771));
+	}
+
+	inline auto make_graph(edge_list const& edges, int nodes) -> gdwg::graph<int, int> {
+		auto g = gdwg::graph<int, int>();
+		for (auto i = 0; i < nodes; ++i) {
+			g.insert_node(i);
+		}
+		for (auto const& [src, dst, weight] : edges) {
+			g.insert_edge(src, dst, weight);
+		}
+		return g;
+	}
+
+	inline auto power_law_graph(int nodes, int edges) -> gdwg::graph<int, int> {
+		return make_graph(power_law_edges(nodes, edges), nodes);
+	}
+
+	// The shape of a benchmark input, passed as the arguments {degree, nodes, edges}.
+	enum class degree : std::int64_t { uniform, power_law };
+
+	inline auto edges_for(::benchmark::State const& state) -> edge_list {
+		auto const nodes = static_cast<int>(state.range(1));
+		auto const edges = static_cast<int>(state.range(2));
+		return static_cast<degree>(state.range(0)) == degree::uniform
+		          ? uniform_edges(nodes, edges)
+		          : power_law_edges(nodes, edges);
+	}
+
+	inline auto graph_for(::benchmark::State const& state) -> gdwg::graph<int, int> {
+		return make_graph(edges_for(state), static_cast<int>(state.range(1)));
+	}
+
+	// Registers every combination of degree distribution and graph size.
+	inline auto graph_shapes(::benchmark::internal::Benchmark* b) -> void {
+		b->ArgNames({"degree", "nodes", "edges"});
+		for (auto const shape : {degree::uniform, degree::power_law}) {
+			b->Args({static_cast<std::int64_t>(shape), 1 << 10, 1 << 13});
+			b->Args({static_cast<std::int64_t>(shape), 1 << 14, 1 << 17});
+		}
+	}
+} // namespace gdwg::benchmark
+
+#endif // GDWG_BENCHMARK_INPUTS_HPP
@@ -0,0 +1,55 @@
+#include "gdwg/graph.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+/*
+    Measures insert_edge throughput on a power-law shaped graph. Most edges leave a handful of
+    hub nodes, which is the case where copying a node's edge set on every insert used to dominate.
+    insert_edges loads the same edges in one bulk call for comparison.
+*/
+
+namespace {
+	void insert_edge_power_law(benchmark::State& state) {
+		auto const nodes = static_cast<int>(state.range(0));
+		auto const edges = gdwg::benchmark::power_law_edges(nodes, static_cast<int>(state.range(1)));
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto g = gdwg::graph<int, int>();
+			for (auto i = 0; i < nodes; ++i) {
+				g.insert_node(i);
+			}
+			state.ResumeTiming();
+			for (auto const& [src, dst, weight] : edges) {
+				benchmark::DoNotOptimize(g.insert_edge(src, dst, weight));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(1));
+	}
+
+	void insert_edges_power_law(benchmark::State& state) {
+		auto const nodes = static_cast<int>(state.range(0));
+		auto const edges = gdwg::benchmark::power_law_edges(nodes, static_cast<int>(state.range(1)));
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto g = gdwg::graph<int, int>();
+			for (auto i = 0; i < nodes; ++i) {
+				g.insert_node(i);
+			}
+			state.ResumeTiming();
+			benchmark::DoNotOptimize(g.insert_edges(edges.begin(), edges.end()));
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(1));
+	}
+} // namespace
+
+BENCHMARK(insert_edge_power_law)
+   ->Args({1 << 10, 1 << 14})
+   ->Args({1 << 12, 1 << 16})
+   ->Args({1 << 16, 1 << 20})
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(insert_edges_power_law)
+   ->Args({1 << 10, 1 << 14})
+   ->Args({1 << 12, 1 << 16})
+   ->Args({1 << 16, 1 << 20})
+   ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,349 @@
+#include "gdwg/graph.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <random>
+#include <sstream>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/*
+    Tracks every public operation of gdwg::graph across releases. Each benchmark runs over the
+    same inputs (see graph_shapes): uniform and power-law degree distributions at two sizes.
+    Modifiers that consume the graph work on an untimed copy and process the whole graph per
+    iteration, so the copy is small next to the timed work. Queries run a fixed batch of random
+    node pairs per iteration.
+*/
+
+namespace {
+	constexpr auto query_count = 1 << 12;
+
+	auto node_values(benchmark::State const& state) -> std::vector<int> {
+		auto result = std::vector<int>(static_cast<std::size_t>(state.range(1)));
+		for (auto i = std::size_t{0}; i < result.size(); ++i) {
+			result[i] = static_cast<int>(i);
+		}
+		return result;
+	}
+
+	// Random (src, dst) pairs, all of which are nodes of the graph.
+	auto query_pairs(benchmark::State const& state) -> std::vector<std::pair<int, int>> {
+		auto rng = std::mt19937(6771);
+		auto node = std::uniform_int_distribution<int>(0, static_cast<int>(state.range(1)) - 1);
+		auto result = std::vector<std::pair<int, int>>();
+		for (auto i = 0; i < query_count; ++i) {
+			auto const src = node(rng);
+			result.emplace_back(src, node(rng));
+		}
+		return result;
+	}
+
+	auto set_edges_processed(benchmark::State& state) -> void {
+		state.SetItemsProcessed(state.iterations() * state.range(2));
+	}
+
+	auto set_nodes_processed(benchmark::State& state) -> void {
+		state.SetItemsProcessed(state.iterations() * state.range(1));
+	}
+
+	// Construction
+
+	void construct_from_range(benchmark::State& state) {
+		auto const nodes = node_values(state);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::graph<int, int>(nodes.begin(), nodes.end()));
+		}
+		set_nodes_processed(state);
+	}
+
+	void insert_node(benchmark::State& state) {
+		auto const nodes = node_values(state);
+		for (auto _ : state) {
+			auto g = gdwg::graph<int, int>();
+			for (auto const node : nodes) {
+				benchmark::DoNotOptimize(g.insert_node(node));
+			}
+		}
+		set_nodes_processed(state);
+	}
+
+	void insert_edge(benchmark::State& state) {
+		auto const nodes = node_values(state);
+		auto const edges = gdwg::benchmark::edges_for(state);
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto g = gdwg::graph<int, int>(nodes.begin(), nodes.end());
+			state.ResumeTiming();
+			for (auto const& [src, dst, weight] : edges) {
+				benchmark::DoNotOptimize(g.insert_edge(src, dst, weight));
+			}
+		}
+		set_edges_processed(state);
+	}
+
+	void insert_edges(benchmark::State& state) {
+		auto const nodes = node_values(state);
+		auto const edges = gdwg::benchmark::edges_for(state);
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto g = gdwg::graph<int, int>(nodes.begin(), nodes.end());
+			state.ResumeTiming();
+			benchmark::DoNotOptimize(g.insert_edges(edges.begin(), edges.end()));
+		}
+		set_edges_processed(state);
+	}
+
+	void copy(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::graph<int, int>(g));
+		}
+		set_edges_processed(state);
+	}
+
+	// Modifiers
+
+	void erase_edge(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		auto edges = gdwg::benchmark::edges_for(state);
+		std::shuffle(edges.begin(), edges.end(), std::mt19937(6771));
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto drained = g;
+			state.ResumeTiming();
+			for (auto const& [src, dst, weight] : edges) {
+				benchmark::DoNotOptimize(drained.erase_edge(src, dst, weight));
+			}
+		}
+		set_edges_processed(state);
+	}
+
+	void erase_edge_iterator(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto drained = g;
+			state.ResumeTiming();
+			while (drained.begin() != drained.end()) {
+				benchmark::DoNotOptimize(drained.erase_edge(drained.begin()));
+			}
+		}
+		set_edges_processed(state);
+	}
+
+	void erase_edge_range(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto drained = g;
+			state.ResumeTiming();
+			benchmark::DoNotOptimize(drained.erase_edge(drained.begin(), drained.end()));
+		}
+		set_edges_processed(state);
+	}
+
+	void erase_node(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		auto nodes = node_values(state);
+		std::shuffle(nodes.begin(), nodes.end(), std::mt19937(6771));
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto drained = g;
+			state.ResumeTiming();
+			for (auto const node : nodes) {
+				benchmark::DoNotOptimize(drained.erase_node(node));
+			}
+		}
+		set_nodes_processed(state);
+	}
+
+	void clear(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto cleared = g;
+			state.ResumeTiming();
+			cleared.clear();
+		}
+		set_edges_processed(state);
+	}
+
+	void replace_node(benchmark::State& state) {
+		auto g = gdwg::benchmark::graph_for(state);
+		auto const nodes = static_cast<int>(state.range(1));
+		// every node is renamed between [0, nodes) and [nodes, 2 * nodes) on alternate iterations
+		auto offset = 0;
+		for (auto _ : state) {
+			auto const next = nodes - offset;
+			for (auto i = 0; i < nodes; ++i) {
+				benchmark::DoNotOptimize(g.replace_node(i + offset, i + next));
+			}
+			offset = next;
+		}
+		set_nodes_processed(state);
+	}
+
+	void merge_replace_node(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		auto const nodes = static_cast<int>(state.range(1));
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto merged = g;
+			state.ResumeTiming();
+			// merges each odd node into the even node before it, halving the graph
+			for (auto i = 1; i < nodes; i += 2) {
+				merged.merge_replace_node(i, i - 1);
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * (state.range(1) / 2));
+	}
+
+	// Accessors
+
+	void is_connected(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		auto const queries = query_pairs(state);
+		for (auto _ : state) {
+			for (auto const& [src, dst] : queries) {
+				benchmark::DoNotOptimize(g.is_connected(src, dst));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * query_count);
+	}
+
+	void weights(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		auto const queries = query_pairs(state);
+		for (auto _ : state) {
+			for (auto const& [src, dst] : queries) {
+				benchmark::DoNotOptimize(g.weights(src, dst));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * query_count);
+	}
+
+	void weights_view(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		auto const queries = query_pairs(state);
+		for (auto _ : state) {
+			for (auto const& [src, dst] : queries) {
+				for (auto const weight : g.weights_view(src, dst)) {
+					benchmark::DoNotOptimize(weight);
+				}
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * query_count);
+	}
+
+	void find(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		// half the lookups are edges of the graph and half are random misses
+		auto const edges = gdwg::benchmark::edges_for(state);
+		auto const misses = query_pairs(state);
+		auto queries = std::vector<std::tuple<int, int, int>>();
+		for (auto i = std::size_t{0}; i < query_count / 2; ++i) {
+			queries.push_back(edges[i % edges.size()]);
+			queries.emplace_back(misses[i].first, misses[i].second, -1);
+		}
+		for (auto _ : state) {
+			for (auto const& [src, dst, weight] : queries) {
+				benchmark::DoNotOptimize(g.find(src, dst, weight));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * query_count);
+	}
+
+	void connections(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		auto const queries = query_pairs(state);
+		for (auto _ : state) {
+			for (auto const& [src, dst] : queries) {
+				benchmark::DoNotOptimize(g.connections(src));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * query_count);
+	}
+
+	void connections_view(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		auto const queries = query_pairs(state);
+		for (auto _ : state) {
+			for (auto const& [src, dst] : queries) {
+				for (auto const& connection : g.connections_view(src)) {
+					benchmark::DoNotOptimize(connection);
+				}
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * query_count);
+	}
+
+	void nodes(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.nodes());
+		}
+		set_nodes_processed(state);
+	}
+
+	// Iteration, comparison and output
+
+	void iterate(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		for (auto _ : state) {
+			auto total = 0L;
+			for (auto const& [from, to, weight] : g) {
+				total += weight;
+			}
+			benchmark::DoNotOptimize(total);
+		}
+		set_edges_processed(state);
+	}
+
+	void equal(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		auto const other = g;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g == other);
+		}
+		set_edges_processed(state);
+	}
+
+	void print(benchmark::State& state) {
+		auto const g = gdwg::benchmark::graph_for(state);
+		for (auto _ : state) {
+			auto out = std::ostringstream();
+			out << g;
+			benchmark::DoNotOptimize(out.str());
+		}
+		set_edges_processed(state);
+	}
+} // namespace
+
+BENCHMARK(construct_from_range)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(insert_node)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(insert_edge)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(insert_edges)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(copy)->Apply(gdwg::benchmark::graph_shapes);
+
+BENCHMARK(erase_edge)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(erase_edge_iterator)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(erase_edge_range)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(erase_node)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(clear)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(replace_node)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(merge_replace_node)->Apply(gdwg::benchmark::graph_shapes);
+
+BENCHMARK(is_connected)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(weights)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(weights_view)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(find)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(connections)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(connections_view)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(nodes)->Apply(gdwg::benchmark::graph_shapes);
+
+BENCHMARK(iterate)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(equal)->Apply(gdwg::benchmark::graph_shapes);
+BENCHMARK(print)->Apply(gdwg::benchmark::graph_shapes);
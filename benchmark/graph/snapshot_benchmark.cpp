@@ -0,0 +1,83 @@
+#include "gdwg/snapshot.hpp"
+#include "inputs.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <filesystem>
+
+/*
+    What a service pays at startup with a snapshot against rebuilding: snapshotting a graph into
+    a csr_graph, writing that to disk, and mapping it back. Mapping should take the same time at
+    both sizes; reading every weight, and verifying the checksum, show the cost of paging the
+    whole file in, which a query-driven service spreads over its first requests.
+*/
+
+namespace {
+	auto snapshot_path() -> std::filesystem::path {
+		return std::filesystem::temp_directory_path() / "gdwg_snapshot_benchmark";
+	}
+
+	auto write_input(benchmark::State const& state) -> void {
+		gdwg::write_snapshot(gdwg::benchmark::power_law_graph(static_cast<int>(state.range(0)),
+		                                                      static_cast<int>(state.range(1))),
+		                     snapshot_path());
+	}
+
+	void rebuild_csr_graph(benchmark::State& state) {
+		auto const g = gdwg::benchmark::power_law_graph(static_cast<int>(state.range(0)),
+		                                                static_cast<int>(state.range(1)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::csr_graph(g));
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(1));
+	}
+
+	void write_snapshot(benchmark::State& state) {
+		auto const g = gdwg::benchmark::power_law_graph(static_cast<int>(state.range(0)),
+		                                                static_cast<int>(state.range(1)));
+		auto const c = gdwg::csr_graph(g);
+		for (auto _ : state) {
+			gdwg::write_snapshot(c, snapshot_path());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(1));
+		std::filesystem::remove(snapshot_path());
+	}
+
+	void map_snapshot(benchmark::State& state) {
+		write_input(state);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::mapped_graph<int, int>(snapshot_path()));
+		}
+		std::filesystem::remove(snapshot_path());
+	}
+
+	void map_and_read_weights(benchmark::State& state) {
+		write_input(state);
+		for (auto _ : state) {
+			auto const m = gdwg::mapped_graph<int, int>(snapshot_path());
+			auto total = std::int64_t{0};
+			for (auto const weight : m.edge_weights()) {
+				total += weight;
+			}
+			benchmark::DoNotOptimize(total);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(1));
+		std::filesystem::remove(snapshot_path());
+	}
+
+	void map_and_verify(benchmark::State& state) {
+		write_input(state);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::mapped_graph<int, int>(snapshot_path()).verify());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(1));
+		std::filesystem::remove(snapshot_path());
+	}
+} // namespace
+
+BENCHMARK(rebuild_csr_graph)->Args({1 << 12, 1 << 16})->Args({1 << 16, 1 << 20});
+BENCHMARK(write_snapshot)->Args({1 << 12, 1 << 16})->Args({1 << 16, 1 << 20});
+BENCHMARK(map_snapshot)->Args({1 << 12, 1 << 16})->Args({1 << 16, 1 << 20});
+BENCHMARK(map_and_read_weights)->Args({1 << 12, 1 << 16})->Args({1 << 16, 1 << 20});
+BENCHMARK(map_and_verify)->Args({1 << 12, 1 << 16})->Args({1 << 16, 1 << 20});
@@ -0,0 +1,229 @@
+#ifndef GDWG_ALGORITHM_BFS_HPP
+#define GDWG_ALGORITHM_BFS_HPP
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace gdwg {
+	struct bfs_options {
+		// 0 uses every hardware thread
+		unsigned threads = 0;
+		// Search bottom-up once the frontier's out-edges exceed 1/alpha of the edges left to
+		// explore, and top-down again once the frontier holds fewer than 1/beta of the nodes.
+		// The defaults are the ones Beamer et al. found to work across graph families.
+		double alpha = 15;
+		double beta = 18;
+	};
+
+	// Breadth-first search results, indexed by csr_graph node id.
+	struct bfs_result {
+		static constexpr auto unreached = std::numeric_limits<std::uint32_t>::max();
+
+		// the number of edges on a shortest path from the source, or unreached
+		std::vector<std::uint32_t> distance;
+		// the node before each reached node on some shortest path from the source, the source
+		// for itself, or unreached. Which parent is recorded may differ between parallel runs.
+		std::vector<std::uint32_t> parent;
+	};
+
+	namespace detail {
+		using bitmap = std::vector<std::uint64_t>;
+
+		inline auto test(bitmap const& bits, std::uint32_t i) noexcept -> bool {
+			return ((bits[i / 64] >> (i % 64)) & 1U) != 0;
+		}
+
+		// State shared by the top-down and bottom-up steps of one search.
+		template<typename G, typename T>
+		struct bfs_search {
+			G const& out;
+			T const& in;
+			unsigned threads;
+			bfs_result& result;
+
+			// Visits the out-edges of every frontier node, claiming unvisited targets with a
+			// compare-and-swap on their parent. Returns the next frontier.
+			auto top_down(std::vector<std::uint32_t> const& frontier, std::uint32_t depth)
+			   -> std::vector<std::uint32_t> {
+				auto const used = parallel_threads(frontier.size(), threads, grain);
+				auto next = std::vector<std::vector<std::uint32_t>>(used);
+				auto const visit = [&](unsigned thread, std::size_t first, std::size_t last) {
+					for (auto i = first; i < last; ++i) {
+						auto const u = frontier[i];
+						for (auto const v : out.out_edges(u)) {
+							auto parent = std::atomic_ref<std::uint32_t>(result.parent[v]);
+							auto expected = bfs_result::unreached;
+							// the plain load skips the compare-and-swap for most visited targets
+							if (parent.load(std::memory_order_relaxed) == expected
+							    && parent.compare_exchange_strong(expected, u, std::memory_order_relaxed))
+							{
+								result.distance[v] = depth;
+								next[thread].push_back(v);
+							}
+						}
+					}
+				};
+				parallel_for(frontier.size(), threads, grain, visit);
+				auto merged = std::move(next[0]);
+				for (auto thread = std::size_t{1}; thread < next.size(); ++thread) {
+					merged.insert(merged.end(), next[thread].begin(), next[thread].end());
+				}
+				return merged;
+			}
+
+			// Checks every unvisited node for an in-edge from the frontier, stopping at the first.
+			// Chunks are whole words of the bitmap, so threads never write the same word.
+			// Returns the size of the next frontier.
+			auto bottom_up(bitmap const& frontier, bitmap& next, std::uint32_t depth)
+			   -> std::size_t {
+				auto const n = static_cast<std::size_t>(out.node_count());
+				auto counts = std::vector<std::size_t>(parallel_threads(n, threads, grain));
+				auto const visit = [&](unsigned thread, std::size_t first, std::size_t last) {
+					for (auto word = first / 64; word < (last + 63) / 64; ++word) {
+						next[word] = 0;
+					}
+					for (auto v = static_cast<std::uint32_t>(first); v < last; ++v) {
+						if (result.parent[v] != bfs_result::unreached) {
+							continue;
+						}
+						for (auto const u : in.out_edges(v)) {
+							if (test(frontier, u)) {
+								result.parent[v] = u;
+								result.distance[v] = depth;
+								next[v / 64] |= std::uint64_t{1} << (v % 64);
+								++counts[thread];
+								break;
+							}
+						}
+					}
+				};
+				parallel_for(n, threads, grain, visit);
+				auto total = std::size_t{0};
+				for (auto const count : counts) {
+					total += count;
+				}
+				return total;
+			}
+
+			// The total out-degree of the nodes in frontier.
+			auto frontier_edges(std::vector<std::uint32_t> const& frontier) const -> std::size_t {
+				auto total = std::size_t{0};
+				for (auto const u : frontier) {
+					total += out.out_degree(u);
+				}
+				return total;
+			}
+
+			// grain is a multiple of 64 so bottom-up chunks own whole bitmap words
+			static constexpr auto grain = std::size_t{4096};
+		};
+	} // namespace detail
+
+	// Direction-optimizing breadth-first search from source (Beamer, Asanović and Patterson).
+	// While the frontier is small each level is expanded top-down from its out-edges; once it
+	// holds a large share of the remaining edges, each unvisited node instead looks for a parent
+	// among its in-edges, stopping at the first one found, which skips most edge checks on
+	// low-diameter graphs. Both directions run in parallel.
+	// transpose must be g.transpose(); passing it lets repeated searches share it.
+	template<csr_view G, csr_view T>
+	auto bfs(G const& g,
+	         T const& transpose,
+	         typename G::node_id source,
+	         bfs_options const& options = {}) -> bfs_result {
+		auto const n = static_cast<std::size_t>(g.node_count());
+		if (source >= n) {
+			throw std::runtime_error("Cannot call gdwg::bfs if source doesn't exist in the graph");
+		}
+		auto result = bfs_result{std::vector<std::uint32_t>(n, bfs_result::unreached),
+		                         std::vector<std::uint32_t>(n, bfs_result::unreached)};
+		auto const threads = options.threads == 0 ? detail::default_threads() : options.threads;
+		auto search = detail::bfs_search<G, T>{g, transpose, threads, result};
+		result.distance[source] = 0;
+		result.parent[source] = source;
+
+		auto frontier = std::vector<std::uint32_t>{source};
+		auto frontier_bits = detail::bitmap((n + 63) / 64);
+		auto next_bits = detail::bitmap(frontier_bits.size());
+		auto edges_to_check = g.edge_count() - g.out_degree(source);
+		auto frontier_edges = static_cast<std::size_t>(g.out_degree(source));
+		auto previous_size = std::size_t{0};
+		for (auto depth = std::uint32_t{1}; !frontier.empty(); ++depth) {
+			// a shrinking frontier stays top-down, or the tail of a high-diameter search would
+			// scan every node per level once few edges are left to explore
+			if (frontier.size() <= previous_size
+			    || static_cast<double>(frontier_edges)
+			          <= static_cast<double>(edges_to_check) / options.alpha)
+			{
+				previous_size = frontier.size();
+				frontier = search.top_down(frontier, depth);
+				frontier_edges = search.frontier_edges(frontier);
+				edges_to_check -= std::min(edges_to_check, frontier_edges);
+				continue;
+			}
+			// bottom-up until the frontier is small and shrinking again
+			std::fill(frontier_bits.begin(), frontier_bits.end(), 0);
+			for (auto const u : frontier) {
+				frontier_bits[u / 64] |= std::uint64_t{1} << (u % 64);
+			}
+			auto size = frontier.size();
+			for (;;) {
+				auto const next_size = search.bottom_up(frontier_bits, next_bits, depth);
+				std::swap(frontier_bits, next_bits);
+				auto const shrinking = next_size < size;
+				size = next_size;
+				if (size == 0
+				    || (shrinking
+				        && static_cast<double>(size) < static_cast<double>(n) / options.beta))
+				{
+					break;
+				}
+				++depth;
+			}
+			frontier.clear();
+			for (auto word = std::size_t{0}; word < frontier_bits.size(); ++word) {
+				for (auto bits = frontier_bits[word]; bits != 0; bits &= bits - 1) {
+					auto const bit = static_cast<std::size_t>(std::countr_zero(bits));
+					frontier.push_back(static_cast<std::uint32_t>(word * 64 + bit));
+				}
+			}
+			previous_size = size;
+			frontier_edges = search.frontier_edges(frontier);
+			edges_to_check = 0;
+			for (auto v = std::size_t{0}; v < n; ++v) {
+				if (result.parent[v] == bfs_result::unreached) {
+					edges_to_check += g.out_degree(static_cast<std::uint32_t>(v));
+				}
+			}
+		}
+		return result;
+	}
+
+	template<csr_view G>
+	auto bfs(G const& g, typename G::node_id source, bfs_options const& options = {})
+	   -> bfs_result {
+		return bfs(g, g.transpose(), source, options);
+	}
+
+	// Searches g from source. Results are indexed by position in g.nodes().
+	template<typename N, typename E, typename Storage>
+	auto bfs(graph<N, E, Storage> const& g, N const& source, bfs_options const& options = {})
+	   -> bfs_result {
+		auto const snapshot = csr_graph<N, E>(g);
+		auto const id = snapshot.id(source);
+		if (!id) {
+			throw std::runtime_error("Cannot call gdwg::bfs if source doesn't exist in the graph");
+		}
+		return bfs(snapshot, *id, options);
+	}
+} // namespace gdwg
+
+#endif // GDWG_ALGORITHM_BFS_HPP
@@ -0,0 +1,20 @@
+#ifndef GDWG_ALGORITHM_COMPONENTS_HPP
+#define GDWG_ALGORITHM_COMPONENTS_HPP
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace gdwg {
+	// A partition of a graph's nodes into components, as one dense label per node rather than
+	// a vector of nodes per component. Indexed by csr_graph node id, or by position in
+	// graph::nodes() for the graph overloads.
+	struct components {
+		static constexpr auto unassigned = std::numeric_limits<std::uint32_t>::max();
+
+		// the number of components, whose labels are 0 to count - 1
+		std::uint32_t count = 0;
+		std::vector<std::uint32_t> component;
+	};
+} // namespace gdwg
+
+#endif // GDWG_ALGORITHM_COMPONENTS_HPP
@@ -0,0 +1,408 @@
+#ifndef GDWG_ALGORITHM_DELTA_STEPPING_HPP
+#define GDWG_ALGORITHM_DELTA_STEPPING_HPP
+#include "gdwg/algorithm/dijkstra.hpp"
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// What a delta-stepping search did, for tuning delta.
+	struct delta_stepping_stats {
+		// the buckets made current, a bucket counting again each time the search comes back to it
+		std::size_t buckets = 0;
+		// how many of those were no later than the bucket made current before them
+		std::size_t revisited = 0;
+	};
+
+	template<typename E>
+	struct delta_stepping_options {
+		// The width of each bucket of tentative distances. Narrow buckets do less wasted work
+		// re-relaxing nodes whose distance later drops; wide ones give each round more nodes to
+		// share between threads. 0 picks the largest weight divided by the average out-degree.
+		E delta = E{};
+		// 0 uses every hardware thread
+		unsigned threads = 0;
+		// filled in with what the search did, if given
+		delta_stepping_stats* stats = nullptr;
+	};
+
+	namespace detail {
+		// The delta used when the caller leaves it at 0.
+		template<csr_view G>
+		auto default_delta(G const& g, typename G::weight_type heaviest) -> typename G::weight_type {
+			using E = typename G::weight_type;
+			auto const nodes = std::max<std::size_t>(1, g.node_count());
+			auto const degree = std::max<std::size_t>(1, g.edge_count() / nodes);
+			auto const delta = static_cast<E>(heaviest / static_cast<E>(degree));
+			return delta > E{} ? delta : E{1};
+		}
+
+		// The bucket of a tentative distance, as a whole number of deltas. It is kept as an E
+		// rather than an index, which a floating point distance many deltas long would overflow.
+		template<typename E>
+		auto bucket_of(E distance, E delta) noexcept -> E {
+			if constexpr (std::is_floating_point_v<E>) {
+				return std::floor(distance / delta);
+			}
+			else {
+				return static_cast<E>(distance / delta);
+			}
+		}
+
+		// ahead buckets as a count of slots, or slots if it is that many or more.
+		template<typename E>
+		auto slots_ahead(E ahead, std::size_t slots) noexcept -> std::size_t {
+			if constexpr (std::is_floating_point_v<E>) {
+				return ahead < static_cast<E>(slots) ? static_cast<std::size_t>(ahead) : slots;
+			}
+			else {
+				return static_cast<std::uintmax_t>(ahead) < slots ? static_cast<std::size_t>(ahead)
+				                                                   : slots;
+			}
+		}
+
+		// The length of the cyclic bucket array. Relaxing an edge lands at most
+		// ceil(heaviest / delta) buckets past the current one, so that many more slots hold every
+		// tentative distance, up to a cap that keeps a few very heavy edges from costing memory.
+		// Distances past the last slot wait in a separate list.
+		template<typename E>
+		auto bucket_slots(E heaviest, E delta) noexcept -> std::size_t {
+			constexpr auto max_slots = std::size_t{1024};
+			auto span = E{};
+			if constexpr (std::is_floating_point_v<E>) {
+				span = std::ceil(heaviest / delta);
+			}
+			else {
+				span = static_cast<E>(heaviest / delta + (heaviest % delta == 0 ? 0 : 1));
+			}
+			return slots_ahead(span, max_slots - 1) + 1;
+		}
+
+		// Lowers distance to candidate unless another thread has already made it lower. Returns
+		// whether it was lowered.
+		template<typename E>
+		auto atomic_min(E& distance, E candidate) noexcept -> bool {
+			auto current = std::atomic_ref<E>(distance);
+			auto expected = current.load(std::memory_order_relaxed);
+			while (candidate < expected) {
+				if (current.compare_exchange_weak(expected, candidate, std::memory_order_relaxed)) {
+					return true;
+				}
+			}
+			return false;
+		}
+	} // namespace detail
+
+	// Parallel single-source shortest paths by delta-stepping (Meyer and Sanders). Nodes are kept
+	// in buckets of tentative distance delta wide, and every node in the lowest non-empty bucket
+	// has its light edges, those no heavier than delta, relaxed at once across threads, repeating
+	// while relaxations land back in that bucket. Once it stays empty the heavy edges of every
+	// node it held are relaxed, once each, as they can only reach later buckets. Each thread keeps
+	// its own buckets, so the only shared writes are the compare-and-swaps on distances. The
+	// buckets form a cyclic array spanning the heaviest edge, so their memory doesn't grow with
+	// the length of the paths. The threads are started once and kept for every round. Weights
+	// must be non-negative, and paths weigh less than numeric_limits<E>::max() as for dijkstra.
+	//
+	// Parents are not tracked while searching, as a parent written after a compare-and-swap can
+	// be overtaken by another thread's. Instead each reached node is given, afterwards, a parent
+	// along an edge whose weight accounts exactly for the difference in distance.
+	template<csr_view G>
+	   requires std::is_arithmetic_v<typename G::weight_type>
+	auto delta_stepping(G const& g,
+	                    typename G::node_id source,
+	                    delta_stepping_options<typename G::weight_type> const& options = {})
+	   -> shortest_paths<typename G::weight_type> {
+		using node_id = typename G::node_id;
+		using E = typename G::weight_type;
+		constexpr auto unreached = shortest_paths<E>::unreached;
+		constexpr auto infinity = shortest_paths<E>::infinity;
+		constexpr auto grain = std::size_t{64};
+		auto const n = static_cast<std::size_t>(g.node_count());
+		if (source >= n) {
+			throw std::runtime_error("Cannot call gdwg::delta_stepping if source doesn't exist in the "
+			                         "graph");
+		}
+		if (options.delta < E{}) {
+			throw std::runtime_error("Cannot call gdwg::delta_stepping with a negative delta");
+		}
+		auto const threads = options.threads == 0 ? detail::default_threads() : options.threads;
+		auto const offsets = g.offsets();
+		auto const targets = g.targets();
+		auto const weights = g.edge_weights();
+		auto const heaviest =
+		   weights.empty() ? E{} : *std::max_element(weights.begin(), weights.end());
+		auto const delta = options.delta == E{} ? detail::default_delta(g, heaviest) : options.delta;
+		auto const slots = detail::bucket_slots(heaviest, delta);
+		auto const has_heavy = delta < heaviest;
+		auto const used = detail::parallel_threads(n, threads, grain);
+
+		auto result = shortest_paths<E>{std::vector<E>(n, infinity),
+		                                std::vector<std::uint32_t>(n, unreached)};
+		auto& distance = result.distance;
+		distance[source] = E{};
+		// A node with the distance it was lowered to. A node may sit in several buckets, and only
+		// the entry matching its current distance does anything.
+		struct entry {
+			node_id node;
+			E distance;
+		};
+		// buckets[thread][(slot + i) % slots] holds what a thread lowered into the bucket i past
+		// the current one, and far[thread] what it lowered past the last slot, as a heap with the
+		// nearest on top. Whenever the current bucket moves on, the far entries it brings within
+		// the slots are moved into them, so every far entry stays past the last slot and the
+		// current bucket never moves back.
+		auto buckets = std::vector<std::vector<std::vector<entry>>>(
+		   used, std::vector<std::vector<entry>>(slots));
+		auto far = std::vector<std::vector<entry>>(used);
+		// The nodes taken from the current bucket, each listed once, whose heavy edges are
+		// relaxed when it stays empty.
+		auto emptied = std::vector<std::vector<node_id>>(used);
+		auto listed = std::vector<std::uint8_t>(has_heavy ? n : 0);
+		auto current = E{};
+		auto slot = std::size_t{0};
+		auto heavy = false;
+		auto frontier = std::vector<entry>{{source, E{}}};
+		auto pending = std::vector<node_id>();
+		auto next = std::atomic<std::size_t>(0);
+		auto negative = std::atomic<bool>(false);
+		auto stats = delta_stepping_stats{.buckets = 1};
+
+		auto const nearer = [](entry const& a, entry const& b) { return b.distance < a.distance; };
+		// How many buckets past the current one d falls, or slots if past the last slot. At or
+		// before the current bucket only through rounding, and relaxed with it.
+		auto const ahead_of = [&](E d) {
+			auto const bucket = detail::bucket_of(d, delta);
+			return current < bucket ? detail::slots_ahead(bucket - current, slots) : 0;
+		};
+		auto const place = [&](unsigned thread, node_id v, E d) {
+			auto const ahead = ahead_of(d);
+			if (ahead == slots) {
+				far[thread].push_back({v, d});
+				std::push_heap(far[thread].begin(), far[thread].end(), nearer);
+			}
+			else {
+				// slot + ahead wraps at most once, which spares a division per relaxation
+				auto const index = slot + ahead;
+				buckets[thread][index < slots ? index : index - slots].push_back({v, d});
+			}
+		};
+		auto const round = [&](unsigned thread) {
+			auto const size = heavy ? pending.size() : frontier.size();
+			for (auto first = next.fetch_add(grain); first < size; first = next.fetch_add(grain)) {
+				auto const last = std::min(first + grain, size);
+				for (auto i = first; heavy && i < last; ++i) {
+					auto const u = pending[i];
+					auto const d = std::atomic_ref<E>(distance[u]).load(std::memory_order_relaxed);
+					for (auto edge = offsets[u], end = offsets[u + 1]; edge < end; ++edge) {
+						auto const weight = weights[edge];
+						if (delta < weight) {
+							auto const v = targets[edge];
+							auto const candidate = detail::extend(d, weight);
+							if (detail::atomic_min(distance[v], candidate)) {
+								place(thread, v, candidate);
+							}
+						}
+					}
+				}
+				for (auto i = first; !heavy && i < last; ++i) {
+					auto const [u, lowered] = frontier[i];
+					auto const d = std::atomic_ref<E>(distance[u]).load(std::memory_order_relaxed);
+					if (d < lowered) {
+						continue; // stale: lowered again since, into this bucket or an earlier one
+					}
+					// listed once per bucket, so its heavy edges are relaxed once
+					auto const first_taken =
+					   has_heavy
+					   && std::atomic_ref<std::uint8_t>(listed[u]).exchange(1, std::memory_order_relaxed)
+					         == 0;
+					if (first_taken) {
+						emptied[thread].push_back(u);
+					}
+					for (auto edge = offsets[u], end = offsets[u + 1]; edge < end; ++edge) {
+						auto const weight = weights[edge];
+						if constexpr (std::is_signed_v<E>) {
+							if (weight < E{}) {
+								negative.store(true, std::memory_order_relaxed);
+								continue;
+							}
+						}
+						if (weight <= delta) {
+							auto const v = targets[edge];
+							auto const candidate = detail::extend(d, weight);
+							if (detail::atomic_min(distance[v], candidate)) {
+								place(thread, v, candidate);
+							}
+						}
+					}
+				}
+			}
+		};
+		// Moves the current bucket of every thread into frontier.
+		auto const gather = [&] {
+			frontier.clear();
+			for (auto& own : buckets) {
+				frontier.insert(frontier.end(), own[slot].begin(), own[slot].end());
+				own[slot].clear();
+			}
+			return !frontier.empty();
+		};
+		// Pops the far entries on top whose node has been lowered since.
+		auto const drop_stale = [&](std::vector<entry>& own) {
+			while (!own.empty() && distance[own.front().node] < own.front().distance) {
+				std::pop_heap(own.begin(), own.end(), nearer);
+				own.pop_back();
+			}
+		};
+		// Makes bucket, at to_slot, the current one and moves the far entries now within the
+		// slots into them.
+		auto const advance = [&](E bucket, std::size_t to_slot) {
+			++stats.buckets;
+			stats.revisited += bucket <= current ? 1 : 0;
+			current = bucket;
+			slot = to_slot;
+			for (auto thread = 0U; thread < used; ++thread) {
+				auto& own = far[thread];
+				for (drop_stale(own); !own.empty() && ahead_of(own.front().distance) < slots;
+				     drop_stale(own))
+				{
+					std::pop_heap(own.begin(), own.end(), nearer);
+					auto const e = own.back();
+					own.pop_back();
+					place(thread, e.node, e.distance);
+				}
+			}
+			return gather();
+		};
+		// Picks what the next round does: the light edges of the current bucket again if anything
+		// landed back in it, then its heavy edges, then the nearest non-empty bucket after it.
+		auto const between = [&] {
+			next.store(0, std::memory_order_relaxed);
+			if (negative.load()) {
+				return false;
+			}
+			// heavy edges land in later buckets, or in this one only by rounding
+			auto const after_heavy = std::exchange(heavy, false);
+			if (gather()) {
+				return true;
+			}
+			if (!after_heavy) {
+				pending.clear();
+				for (auto& own : emptied) {
+					for (auto const u : own) {
+						listed[u] = 0;
+					}
+					pending.insert(pending.end(), own.begin(), own.end());
+					own.clear();
+				}
+				if (!pending.empty()) {
+					heavy = true;
+					return true;
+				}
+			}
+			for (auto step = std::size_t{1}; step < slots; ++step) {
+				auto const candidate = (slot + step) % slots;
+				if (std::any_of(buckets.begin(), buckets.end(), [candidate](auto const& own) {
+					    return !own[candidate].empty();
+				    }))
+				{
+					return advance(static_cast<E>(current + static_cast<E>(step)), candidate);
+				}
+			}
+			// every slot is empty, so jump to the nearest bucket held past them
+			auto lowest = std::optional<E>();
+			for (auto& own : far) {
+				drop_stale(own);
+				if (!own.empty()) {
+					auto const bucket = detail::bucket_of(own.front().distance, delta);
+					lowest = lowest ? std::min(*lowest, bucket) : bucket;
+				}
+			}
+			return lowest && advance(*lowest, slot);
+		};
+		detail::parallel_rounds(used, round, between);
+		if (options.stats != nullptr) {
+			*options.stats = stats;
+		}
+		if (negative.load()) {
+			throw std::runtime_error("Cannot call gdwg::delta_stepping on a graph with negative "
+			                         "edge weights");
+		}
+
+		// Parents along tight edges. Edges between nodes at the same distance, which need a weight
+		// of 0 or one lost to rounding, are skipped here as two nodes could name each other, and
+		// are resolved below instead.
+		auto& parent = result.parent;
+		parent[source] = source;
+		auto const tight = [&](unsigned, std::size_t first, std::size_t last) {
+			for (auto u = static_cast<node_id>(first); u < last; ++u) {
+				if (distance[u] == infinity) {
+					continue;
+				}
+				for (auto edge = offsets[u]; edge < offsets[u + 1]; ++edge) {
+					auto const v = targets[edge];
+					if (distance[u] < distance[v]
+					    && detail::extend(distance[u], weights[edge]) == distance[v]) {
+						auto expected = unreached;
+						std::atomic_ref<std::uint32_t>(parent[v])
+						   .compare_exchange_strong(expected, u, std::memory_order_relaxed);
+					}
+				}
+			}
+		};
+		detail::parallel_for(n, threads, 4096, tight);
+		// Whatever is left is reached only through such edges, so search outwards along them from
+		// the nodes that already have a parent.
+		auto missing = false;
+		for (auto v = std::size_t{0}; v < n && !missing; ++v) {
+			missing = distance[v] != infinity && parent[v] == unreached;
+		}
+		if (missing) {
+			auto queue = std::vector<node_id>();
+			for (auto v = node_id{0}; v < n; ++v) {
+				if (parent[v] != unreached) {
+					queue.push_back(v);
+				}
+			}
+			for (auto i = std::size_t{0}; i < queue.size(); ++i) {
+				auto const u = queue[i];
+				for (auto edge = offsets[u]; edge < offsets[u + 1]; ++edge) {
+					auto const v = targets[edge];
+					if (parent[v] == unreached && distance[u] == distance[v]
+					    && detail::extend(distance[u], weights[edge]) == distance[v]) {
+						parent[v] = u;
+						queue.push_back(v);
+					}
+				}
+			}
+		}
+		return result;
+	}
+
+	// Delta-stepping from source in g. Results are indexed by position in g.nodes().
+	template<typename N, typename E, typename Storage>
+	auto delta_stepping(graph<N, E, Storage> const& g,
+	                    N const& source,
+	                    delta_stepping_options<E> const& options = {}) -> shortest_paths<E> {
+		auto const snapshot = csr_graph<N, E>(g);
+		auto const id = snapshot.id(source);
+		if (!id) {
+			throw std::runtime_error("Cannot call gdwg::delta_stepping if source doesn't exist in the "
+			                         "graph");
+		}
+		return delta_stepping(snapshot, *id, options);
+	}
+} // namespace gdwg
+
+#endif // GDWG_ALGORITHM_DELTA_STEPPING_HPP
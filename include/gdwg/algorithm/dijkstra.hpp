@@ -0,0 +1,243 @@
+#ifndef GDWG_ALGORITHM_DIJKSTRA_HPP
+#define GDWG_ALGORITHM_DIJKSTRA_HPP
+#include "gdwg/algorithm/heap.hpp"
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// Single-source shortest path results, indexed by csr_graph node id.
+	template<typename E>
+	struct shortest_paths {
+		static constexpr auto unreached = std::numeric_limits<std::uint32_t>::max();
+		static constexpr auto infinity = std::numeric_limits<E>::max();
+
+		// the weight of a shortest path from the source, or infinity
+		std::vector<E> distance;
+		// the node before each reached node on a shortest path from the source, the source for
+		// itself, or unreached
+		std::vector<std::uint32_t> parent;
+	};
+
+	namespace detail {
+		// The distance d extended by a non-negative weight. For an integral E it saturates at
+		// shortest_paths<E>::infinity instead of overflowing, which would be undefined for a
+		// signed E and would wrap round to a shorter distance for an unsigned one.
+		template<typename E>
+		constexpr auto extend(E d, E weight) noexcept -> E {
+			if constexpr (std::is_integral_v<E>) {
+				constexpr auto infinity = shortest_paths<E>::infinity;
+				return weight < infinity - d ? static_cast<E>(d + weight) : infinity;
+			}
+			else {
+				return d + weight;
+			}
+		}
+	} // namespace detail
+
+	// Dijkstra's algorithm over a csr_graph with non-negative arithmetic weights, or over any
+	// other csr_view, such as a mapped_graph, given as Graph. Queue picks the priority queue from
+	// heap.hpp: binary_heap, quaternary_heap, or radix_heap when E is an integer type. Only the
+	// lightest of several edges between the same pair of nodes is relaxed; the snapshot orders
+	// them by weight, so the others are skipped without being read. Any weight from 0 to
+	// numeric_limits<E>::max() is accepted, but a path must weigh less than that in total: one
+	// that would reach it saturates at infinity instead of overflowing, so its end is left
+	// unreached.
+	//
+	// A search object keeps its arrays and queue between runs and only resets the nodes the
+	// previous run touched, so many point-to-point queries on one graph cost time proportional
+	// to the part of the graph they explore rather than its size. It refers to g, which must
+	// outlive it.
+	template<typename N,
+	         typename E,
+	         template<typename, typename> typename Queue = binary_heap,
+	         csr_view Graph = csr_graph<N, E>>
+	   requires std::is_arithmetic_v<E> && std::same_as<typename Graph::weight_type, E>
+	class dijkstra_search {
+	public:
+		using node_id = typename Graph::node_id;
+		static constexpr auto unreached = shortest_paths<E>::unreached;
+		static constexpr auto infinity = shortest_paths<E>::infinity;
+
+		explicit dijkstra_search(Graph const& g)
+		: g_(g)
+		, distance_(g.node_count(), infinity)
+		, parent_(g.node_count(), unreached) {}
+
+		// Finds the shortest paths from source to every node.
+		auto run(node_id source) -> void {
+			search(source, std::nullopt);
+		}
+
+		// Finds a shortest path from source to target, stopping as soon as target is settled.
+		// Nodes that were not settled on the way may be left with longer tentative distances.
+		// Returns whether target is reachable.
+		auto run(node_id source, node_id target) -> bool {
+			check(target);
+			search(source, target);
+			return reached(target);
+		}
+
+		[[nodiscard]] auto reached(node_id v) const noexcept -> bool {
+			return parent_[v] != unreached;
+		}
+		[[nodiscard]] auto distance(node_id v) const noexcept -> E {
+			return distance_[v];
+		}
+		[[nodiscard]] auto parent(node_id v) const noexcept -> node_id {
+			return parent_[v];
+		}
+
+		// The nodes on the path found to target, from the source to target, or an empty vector
+		// if target was not reached.
+		[[nodiscard]] auto path(node_id target) const -> std::vector<node_id> {
+			auto result = std::vector<node_id>();
+			if (!reached(target)) {
+				return result;
+			}
+			for (auto v = target;; v = parent_[v]) {
+				result.push_back(v);
+				if (parent_[v] == v) {
+					break;
+				}
+			}
+			std::reverse(result.begin(), result.end());
+			return result;
+		}
+
+		// A copy of the results of the last run.
+		[[nodiscard]] auto result() const -> shortest_paths<E> {
+			return {distance_, parent_};
+		}
+
+	private:
+		auto check(node_id v) const -> void {
+			if (v >= g_.node_count()) {
+				throw std::runtime_error("Cannot call gdwg::dijkstra if source or target doesn't "
+				                         "exist in the graph");
+			}
+		}
+
+		auto search(node_id source, std::optional<node_id> target) -> void {
+			check(source);
+			for (auto const v : touched_) {
+				distance_[v] = infinity;
+				parent_[v] = unreached;
+			}
+			touched_.clear();
+			queue_.clear();
+
+			distance_[source] = E{};
+			parent_[source] = source;
+			touched_.push_back(source);
+			queue_.push(E{}, source);
+			auto const offsets = g_.offsets();
+			auto const targets = g_.targets();
+			auto const weights = g_.edge_weights();
+			while (!queue_.empty()) {
+				auto const [d, u] = queue_.pop();
+				if (distance_[u] < d) {
+					continue; // stale: u was reached more cheaply after this entry was pushed
+				}
+				if (target && u == *target) {
+					return;
+				}
+				for (auto i = offsets[u]; i < offsets[u + 1]; ++i) {
+					auto const v = targets[i];
+					if (i > offsets[u] && targets[i - 1] == v) {
+						continue; // a heavier parallel edge
+					}
+					if constexpr (std::is_signed_v<E>) {
+						if (weights[i] < E{}) {
+							throw std::runtime_error("Cannot call gdwg::dijkstra on a graph with "
+							                         "negative edge weights");
+						}
+					}
+					auto const candidate = detail::extend(d, weights[i]);
+					if (candidate < distance_[v]) {
+						if (parent_[v] == unreached) {
+							touched_.push_back(v);
+						}
+						distance_[v] = candidate;
+						parent_[v] = u;
+						queue_.push(candidate, v);
+					}
+				}
+			}
+		}
+
+		Graph const& g_;
+		std::vector<E> distance_;
+		std::vector<node_id> parent_;
+		std::vector<node_id> touched_;
+		Queue<E, node_id> queue_;
+	};
+
+	template<csr_view G>
+	dijkstra_search(G const&)
+	   -> dijkstra_search<typename G::node_type, typename G::weight_type, binary_heap, G>;
+
+	// Shortest paths from source to every node of g.
+	template<template<typename, typename> typename Queue = binary_heap, csr_view G>
+	auto dijkstra(G const& g, typename G::node_id source)
+	   -> shortest_paths<typename G::weight_type> {
+		using N = typename G::node_type;
+		using E = typename G::weight_type;
+		auto search = dijkstra_search<N, E, Queue, G>(g);
+		search.run(source);
+		return search.result();
+	}
+
+	// Shortest paths from source in g. Results are indexed by position in g.nodes().
+	template<template<typename, typename> typename Queue = binary_heap,
+	         typename N,
+	         typename E,
+	         typename Storage>
+	auto dijkstra(graph<N, E, Storage> const& g, N const& source) -> shortest_paths<E> {
+		auto const snapshot = csr_graph<N, E>(g);
+		auto const id = snapshot.id(source);
+		if (!id) {
+			throw std::runtime_error("Cannot call gdwg::dijkstra if source or target doesn't exist "
+			                         "in the graph");
+		}
+		return dijkstra<Queue>(snapshot, *id);
+	}
+
+	// The weight and nodes of a shortest path from src to dst in g, or std::nullopt if dst is
+	// not reachable from src. The search stops as soon as dst is settled.
+	template<template<typename, typename> typename Queue = binary_heap,
+	         typename N,
+	         typename E,
+	         typename Storage>
+	auto shortest_path(graph<N, E, Storage> const& g, N const& src, N const& dst)
+	   -> std::optional<std::pair<E, std::vector<N>>> {
+		auto const snapshot = csr_graph<N, E>(g);
+		auto const src_id = snapshot.id(src);
+		auto const dst_id = snapshot.id(dst);
+		if (!src_id || !dst_id) {
+			throw std::runtime_error("Cannot call gdwg::dijkstra if source or target doesn't exist "
+			                         "in the graph");
+		}
+		auto search = dijkstra_search<N, E, Queue>(snapshot);
+		if (!search.run(*src_id, *dst_id)) {
+			return std::nullopt;
+		}
+		auto nodes = std::vector<N>();
+		for (auto const v : search.path(*dst_id)) {
+			nodes.push_back(snapshot.node(v));
+		}
+		return std::pair{search.distance(*dst_id), std::move(nodes)};
+	}
+} // namespace gdwg
+
+#endif // GDWG_ALGORITHM_DIJKSTRA_HPP
@@ -0,0 +1,168 @@
+#ifndef GDWG_ALGORITHM_HEAP_HPP
+#define GDWG_ALGORITHM_HEAP_HPP
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Min-priority queues of (key, value) pairs for the shortest path algorithms. None of them
+// support decrease-key: a search pushes a node again when its distance improves and skips the
+// stale entries as they come out, which is faster in practice than tracking heap positions.
+// Each provides push(key, value), pop() -> pair, empty(), size() and clear(), and keeps its
+// storage across clear() so a reused queue stops allocating.
+namespace gdwg {
+	// An implicit heap where every node has Arity children. Wider heaps are shallower, so a pop
+	// does fewer levels of work on contiguous children, at the cost of more comparisons per level.
+	template<typename Key, typename Value, std::size_t Arity>
+	class d_ary_heap {
+		static_assert(Arity >= 2);
+
+	public:
+		using key_type = Key;
+		using value_type = Value;
+
+		auto push(Key key, Value value) -> void {
+			auto hole = heap_.size();
+			heap_.emplace_back();
+			while (hole > 0) {
+				auto const parent = (hole - 1) / Arity;
+				if (!(key < heap_[parent].first)) {
+					break;
+				}
+				heap_[hole] = std::move(heap_[parent]);
+				hole = parent;
+			}
+			heap_[hole] = {std::move(key), std::move(value)};
+		}
+
+		// Removes and returns an entry with the smallest key. The heap must not be empty.
+		auto pop() -> std::pair<Key, Value> {
+			auto top = std::move(heap_.front());
+			auto last = std::move(heap_.back());
+			heap_.pop_back();
+			auto const size = heap_.size();
+			if (size == 0) {
+				return top;
+			}
+			auto hole = std::size_t{0};
+			for (;;) {
+				auto const first_child = hole * Arity + 1;
+				if (first_child >= size) {
+					break;
+				}
+				auto const last_child = std::min(first_child + Arity, size);
+				auto smallest = first_child;
+				for (auto child = first_child + 1; child < last_child; ++child) {
+					if (heap_[child].first < heap_[smallest].first) {
+						smallest = child;
+					}
+				}
+				if (!(heap_[smallest].first < last.first)) {
+					break;
+				}
+				heap_[hole] = std::move(heap_[smallest]);
+				hole = smallest;
+			}
+			heap_[hole] = std::move(last);
+			return top;
+		}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return heap_.empty();
+		}
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return heap_.size();
+		}
+		auto clear() noexcept -> void {
+			heap_.clear();
+		}
+
+	private:
+		std::vector<std::pair<Key, Value>> heap_;
+	};
+
+	template<typename Key, typename Value>
+	using binary_heap = d_ary_heap<Key, Value, 2>;
+
+	template<typename Key, typename Value>
+	using quaternary_heap = d_ary_heap<Key, Value, 4>;
+
+	// A monotone queue for non-negative integer keys: no key pushed may be smaller than the last
+	// key popped, which Dijkstra's algorithm guarantees. Entries sit in buckets by the highest bit
+	// in which their key differs from the last key popped, so each entry moves to a lower bucket
+	// at most once per bit of Key, and push is O(1).
+	template<std::integral Key, typename Value>
+	class radix_heap {
+		using bits_type = std::make_unsigned_t<Key>;
+		static constexpr auto bucket_count = std::numeric_limits<bits_type>::digits + 1;
+
+	public:
+		using key_type = Key;
+		using value_type = Value;
+
+		auto push(Key key, Value value) -> void {
+			auto const bits = static_cast<bits_type>(key);
+			buckets_[bucket(bits)].emplace_back(bits, std::move(value));
+			++size_;
+		}
+
+		// Removes and returns an entry with the smallest key. The heap must not be empty.
+		auto pop() -> std::pair<Key, Value> {
+			if (buckets_[0].empty()) {
+				refill();
+			}
+			auto [bits, value] = std::move(buckets_[0].back());
+			buckets_[0].pop_back();
+			--size_;
+			return {static_cast<Key>(bits), std::move(value)};
+		}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return size_ == 0;
+		}
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return size_;
+		}
+		auto clear() noexcept -> void {
+			for (auto& entries : buckets_) {
+				entries.clear();
+			}
+			size_ = 0;
+			last_ = 0;
+		}
+
+	private:
+		auto bucket(bits_type bits) const noexcept -> std::size_t {
+			return static_cast<std::size_t>(std::bit_width(static_cast<bits_type>(bits ^ last_)));
+		}
+
+		// Moves the smallest key into last_ and redistributes its bucket, all of whose entries
+		// then land in lower buckets, at least one of them in bucket 0.
+		auto refill() -> void {
+			auto i = std::size_t{1};
+			while (buckets_[i].empty()) {
+				++i;
+			}
+			auto& source = buckets_[i];
+			last_ = source.front().first;
+			for (auto const& entry : source) {
+				last_ = std::min(last_, entry.first);
+			}
+			for (auto& entry : source) {
+				buckets_[bucket(entry.first)].push_back(std::move(entry));
+			}
+			source.clear();
+		}
+
+		std::array<std::vector<std::pair<bits_type, Value>>, bucket_count> buckets_;
+		std::size_t size_ = 0;
+		bits_type last_ = 0;
+	};
+} // namespace gdwg
+
+#endif // GDWG_ALGORITHM_HEAP_HPP
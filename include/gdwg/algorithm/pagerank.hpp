@@ -0,0 +1,258 @@
+#ifndef GDWG_ALGORITHM_PAGERANK_HPP
+#define GDWG_ALGORITHM_PAGERANK_HPP
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	struct pagerank_options {
+		// the probability of following an edge rather than teleporting
+		double damping = 0.85;
+		// stop once an iteration changes the ranks by less than this in total (L1 norm)
+		double tolerance = 1e-6;
+		std::size_t max_iterations = 100;
+		// Follow each out-edge in proportion to its weight rather than uniformly. Every edge
+		// is a separate link either way, so parallel edges add up.
+		bool weighted = false;
+		// 0 uses every hardware thread
+		unsigned threads = 0;
+	};
+
+	struct pagerank_result {
+		// indexed by csr_graph node id, summing to 1
+		std::vector<double> rank;
+		std::size_t iterations = 0;
+		bool converged = false;
+	};
+
+	namespace detail {
+		// Power iteration pulling along in-edges: each node sums what its in-neighbours send it,
+		// so every rank is written by exactly one thread and no atomics are needed. Each
+		// iteration is one pass over the nodes in chunks. For each node, the pass gathers its new
+		// rank and accumulates the change and the dangling rank. It also computes what the node
+		// will send next time, its rank times 1 / out-degree. So the per-edge work is a scalar
+		// indexed load and add, with a multiply by the edge's share when weighted. Nothing is
+		// vectorised by hand. The sum order depends only on the graph, so results are identical
+		// for any number of threads.
+		template<typename T>
+		class pagerank_solver {
+		public:
+			template<typename G>
+			pagerank_solver(G const& g,
+			                T const& transpose,
+			                std::vector<double> teleport,
+			                pagerank_options const& options)
+			: transpose_(transpose)
+			, options_(options)
+			, threads_(options.threads == 0 ? default_threads() : options.threads)
+			, teleport_(std::move(teleport))
+			, scale_(g.node_count()) {
+				auto const n = static_cast<std::size_t>(g.node_count());
+				using E = typename G::weight_type;
+				if (options.weighted) {
+					// the weight of each in-edge as a share of its source's total out-weight
+					auto total = std::vector<double>(n);
+					for (auto u = std::size_t{0}; u < n; ++u) {
+						for (auto const weight : g.out_weights(static_cast<std::uint32_t>(u))) {
+							if constexpr (std::is_signed_v<E>) {
+								if (weight < E{}) {
+									throw std::runtime_error("Cannot call gdwg::pagerank with negative "
+									                         "weights when options.weighted is set");
+								}
+							}
+							total[u] += static_cast<double>(weight);
+						}
+					}
+					auto const sources = transpose.targets();
+					auto const weights = transpose.edge_weights();
+					share_.resize(sources.size());
+					for (auto e = std::size_t{0}; e < sources.size(); ++e) {
+						auto const out = total[sources[e]];
+						share_[e] = out > 0 ? static_cast<double>(weights[e]) / out : 0.0;
+					}
+					for (auto u = std::size_t{0}; u < n; ++u) {
+						scale_[u] = total[u] > 0 ? 1.0 : 0.0;
+					}
+				}
+				else {
+					for (auto u = std::size_t{0}; u < n; ++u) {
+						auto const degree = g.out_degree(static_cast<std::uint32_t>(u));
+						scale_[u] = degree > 0 ? 1.0 / static_cast<double>(degree) : 0.0;
+					}
+				}
+			}
+
+			auto solve() -> pagerank_result {
+				auto const n = teleport_.size();
+				auto result = pagerank_result{teleport_};
+				if (n == 0) {
+					result.converged = true;
+					return result;
+				}
+				auto& rank = result.rank;
+				auto next = std::vector<double>(n);
+				// what each node sends along each of its out-edges, for this iteration and the next
+				auto sent = std::vector<double>(n);
+				auto next_sent = std::vector<double>(n);
+				// the rank held by nodes with no out-edges, which is spread like a teleport
+				auto dangling = 0.0;
+				for (auto u = std::size_t{0}; u < n; ++u) {
+					sent[u] = rank[u] * scale_[u];
+					dangling += scale_[u] == 0 ? rank[u] : 0.0;
+				}
+				auto const chunks = (n + grain - 1) / grain;
+				auto dangling_parts = std::vector<double>(chunks);
+				auto change_parts = std::vector<double>(chunks);
+				auto const damping = options_.damping;
+				auto const update = [&](unsigned, std::size_t first, std::size_t last) {
+					auto const teleported = 1 - damping + damping * dangling;
+					auto next_dangling = 0.0;
+					auto change = 0.0;
+					for (auto v = first; v < last; ++v) {
+						next[v] = teleported * teleport_[v]
+						          + damping * gather(sent, static_cast<std::uint32_t>(v));
+						change += std::abs(next[v] - rank[v]);
+						next_sent[v] = next[v] * scale_[v];
+						next_dangling += scale_[v] == 0 ? next[v] : 0.0;
+					}
+					dangling_parts[first / grain] = next_dangling;
+					change_parts[first / grain] = change;
+				};
+				while (result.iterations < options_.max_iterations) {
+					++result.iterations;
+					parallel_for(n, threads_, grain, update);
+					std::swap(rank, next);
+					std::swap(sent, next_sent);
+					dangling = sum(dangling_parts);
+					if (sum(change_parts) < options_.tolerance) {
+						result.converged = true;
+						break;
+					}
+				}
+				return result;
+			}
+
+		private:
+			// The sum of sent over v's in-neighbours, weighted by share_ if set.
+			auto gather(std::vector<double> const& sent, std::uint32_t v) const noexcept -> double {
+				auto const offsets = transpose_.offsets();
+				auto const* sources = transpose_.targets().data();
+				auto pulled = 0.0;
+				if (share_.empty()) {
+					for (auto e = offsets[v]; e < offsets[v + 1]; ++e) {
+						pulled += sent[sources[e]];
+					}
+				}
+				else {
+					for (auto e = offsets[v]; e < offsets[v + 1]; ++e) {
+						pulled += sent[sources[e]] * share_[e];
+					}
+				}
+				return pulled;
+			}
+
+			static auto sum(std::vector<double> const& parts) noexcept -> double {
+				auto total = 0.0;
+				for (auto const part : parts) {
+					total += part;
+				}
+				return total;
+			}
+
+			static constexpr auto grain = std::size_t{2048};
+
+			T const& transpose_;
+			pagerank_options options_;
+			unsigned threads_;
+			std::vector<double> teleport_;
+			// 1 / out-degree, or with weights 1 for any node with out-weight; 0 marks dangling
+			std::vector<double> scale_;
+			// per in-edge transition probabilities, only when weighted
+			std::vector<double> share_;
+		};
+	} // namespace detail
+
+	// PageRank by power iteration over the transpose of g, with teleports spread uniformly.
+	// Nodes without out-edges, or whose out-edges all weigh 0 when weighted, teleport.
+	// transpose must be g.transpose().
+	template<csr_view G, csr_view T>
+	   requires std::is_arithmetic_v<typename G::weight_type>
+	auto pagerank(G const& g, T const& transpose, pagerank_options const& options = {})
+	   -> pagerank_result {
+		auto const n = static_cast<std::size_t>(g.node_count());
+		auto teleport = std::vector<double>(n, n == 0 ? 0.0 : 1.0 / static_cast<double>(n));
+		return detail::pagerank_solver<T>(g, transpose, std::move(teleport), options).solve();
+	}
+
+	template<csr_view G>
+	   requires std::is_arithmetic_v<typename G::weight_type>
+	auto pagerank(G const& g, pagerank_options const& options = {}) -> pagerank_result {
+		return pagerank(g, g.transpose(), options);
+	}
+
+	// Personalized PageRank: teleports land on each node in proportion to its entry in
+	// personalization, which is indexed by node id, so ranks measure closeness to the nodes
+	// given weight.
+	template<csr_view G, csr_view T>
+	   requires std::is_arithmetic_v<typename G::weight_type>
+	auto personalized_pagerank(G const& g,
+	                           T const& transpose,
+	                           std::span<double const> personalization,
+	                           pagerank_options const& options = {}) -> pagerank_result {
+		auto total = 0.0;
+		for (auto const weight : personalization) {
+			total += weight;
+		}
+		if (personalization.size() != g.node_count() || !(total > 0)
+		    || std::any_of(personalization.begin(), personalization.end(), [](double weight) {
+			       return weight < 0;
+		       }))
+		{
+			throw std::runtime_error("Cannot call gdwg::personalized_pagerank without a non-negative "
+			                         "weight for every node and a positive total");
+		}
+		auto teleport = std::vector<double>(personalization.begin(), personalization.end());
+		for (auto& weight : teleport) {
+			weight /= total;
+		}
+		return detail::pagerank_solver<T>(g, transpose, std::move(teleport), options).solve();
+	}
+
+	// PageRank of g, indexed by position in g.nodes().
+	template<typename N, typename E, typename Storage>
+	auto pagerank(graph<N, E, Storage> const& g, pagerank_options const& options = {})
+	   -> pagerank_result {
+		return pagerank(csr_graph<N, E>(g), options);
+	}
+
+	// Personalized PageRank of g with teleports to the given nodes in proportion to their
+	// weights, indexed by position in g.nodes().
+	template<typename N, typename E, typename Storage>
+	auto personalized_pagerank(graph<N, E, Storage> const& g,
+	                           std::vector<std::pair<N, double>> const& personalization,
+	                           pagerank_options const& options = {}) -> pagerank_result {
+		auto const snapshot = csr_graph<N, E>(g);
+		auto weights = std::vector<double>(snapshot.node_count());
+		for (auto const& [value, weight] : personalization) {
+			auto const id = snapshot.id(value);
+			if (!id) {
+				throw std::runtime_error("Cannot call gdwg::personalized_pagerank with a node that "
+				                         "doesn't exist in the graph");
+			}
+			weights[*id] += weight;
+		}
+		return personalized_pagerank(snapshot, snapshot.transpose(), weights, options);
+	}
+} // namespace gdwg
+
+#endif // GDWG_ALGORITHM_PAGERANK_HPP
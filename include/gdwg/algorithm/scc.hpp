@@ -0,0 +1,334 @@
+#ifndef GDWG_ALGORITHM_SCC_HPP
+#define GDWG_ALGORITHM_SCC_HPP
+#include "gdwg/algorithm/components.hpp"
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// Strongly connected components by Tarjan's algorithm, with the depth-first search kept on
+	// an explicit stack so that long paths cannot overflow the call stack. Components are
+	// labelled in the order Tarjan's algorithm completes them, which is a reverse topological
+	// order of the condensation: an edge from one component to another always points to the
+	// lower label.
+	template<csr_view G>
+	auto tarjan_scc(G const& g) -> components {
+		using node_id = typename G::node_id;
+		constexpr auto unvisited = components::unassigned;
+		auto const n = static_cast<std::size_t>(g.node_count());
+		auto const offsets = g.offsets();
+		auto const targets = g.targets();
+
+		auto result = components{0, std::vector<std::uint32_t>(n, components::unassigned)};
+		auto& component = result.component;
+		// the order in which the search reached each node, and the lowest of those reachable
+		// from it through its descendants and back edges
+		auto index = std::vector<std::uint32_t>(n, unvisited);
+		auto low = std::vector<std::uint32_t>(n);
+		// nodes visited but not yet given a component
+		auto open = std::vector<node_id>();
+		// the search path, with the next out-edge each node on it will follow
+		auto path = std::vector<std::pair<node_id, std::size_t>>();
+		auto next_index = std::uint32_t{0};
+		auto const visit = [&](node_id v) {
+			index[v] = low[v] = next_index++;
+			open.push_back(v);
+			path.emplace_back(v, offsets[v]);
+		};
+
+		for (auto root = node_id{0}; root < n; ++root) {
+			if (index[root] != unvisited) {
+				continue;
+			}
+			visit(root);
+			while (!path.empty()) {
+				auto& [u, edge] = path.back();
+				if (edge < offsets[u + 1]) {
+					auto const v = targets[edge++];
+					if (index[v] == unvisited) {
+						visit(v); // invalidates u and edge
+					}
+					else if (component[v] == components::unassigned) {
+						low[u] = std::min(low[u], index[v]);
+					}
+					continue;
+				}
+				auto const finished = u;
+				path.pop_back();
+				if (low[finished] == index[finished]) {
+					auto v = node_id{0};
+					do {
+						v = open.back();
+						open.pop_back();
+						component[v] = result.count;
+					} while (v != finished);
+					++result.count;
+				}
+				if (!path.empty()) {
+					auto const parent = path.back().first;
+					low[parent] = std::min(low[parent], low[finished]);
+				}
+			}
+		}
+		return result;
+	}
+
+	struct scc_options {
+		// 0 uses every hardware thread
+		unsigned threads = 0;
+	};
+
+	namespace detail {
+		// The state of a parallel strongly connected components search. Each phase finds whole
+		// components among the nodes still unassigned, so every phase can ignore the rest.
+		template<typename G, typename T>
+		class parallel_scc_search {
+		public:
+			using node_id = typename G::node_id;
+
+			parallel_scc_search(G const& out, T const& in, unsigned threads)
+			: out_(out)
+			, in_(in)
+			, threads_(threads)
+			, component_(out.node_count(), components::unassigned) {}
+
+			// Gives each node with no unassigned in-neighbours or no unassigned out-neighbours its
+			// own component, as no cycle can pass through it, then rechecks the neighbours of the
+			// nodes it took, until none are left. This peels off chains and trees, which make up
+			// much of a typical dependency graph and are the worst case for colouring.
+			auto trim() -> void {
+				auto const take = [&](node_id u, std::vector<node_id>& next) {
+					if (!is_unassigned(u) || !(isolated(out_, u) || isolated(in_, u))
+					    || !claim(u, next_label_.fetch_add(1, std::memory_order_relaxed)))
+					{
+						return;
+					}
+					for (auto const edges : {out_.out_edges(u), in_.out_edges(u)}) {
+						for (auto const v : edges) {
+							if (v != u && is_unassigned(v)) {
+								next.push_back(v);
+							}
+						}
+					}
+				};
+				for (auto candidates = unassigned_nodes(); !candidates.empty();) {
+					candidates = parallel_expand(candidates, threads_, grain, take);
+				}
+			}
+
+			// Finds the component of the unassigned node with the most edges as the nodes both
+			// reachable from it and reaching it. Real graphs tend to have one giant component,
+			// which this takes out in two traversals.
+			auto forward_backward() -> void {
+				auto pivot = components::unassigned;
+				auto best = std::size_t{0};
+				for (auto const u : unassigned_nodes()) {
+					auto const degree = out_.out_degree(u) * in_.out_degree(u);
+					if (pivot == components::unassigned || degree > best) {
+						pivot = u;
+						best = degree;
+					}
+				}
+				if (pivot == components::unassigned) {
+					return;
+				}
+				// forward marks 1, then backward within those marks 2
+				auto mark = std::vector<std::uint8_t>(component_.size());
+				reach(out_, pivot, mark, 0, 1);
+				reach(in_, pivot, mark, 1, 2);
+				auto const label = next_label_.fetch_add(1, std::memory_order_relaxed);
+				parallel_for(mark.size(), threads_, 4096, [&](unsigned, auto first, auto last) {
+					for (auto v = first; v < last; ++v) {
+						if (mark[v] == 2) {
+							component_[v] = label;
+						}
+					}
+				});
+			}
+
+			// Assigns all remaining nodes by colouring (Orzan): every node takes the largest id
+			// that reaches it, so each colour class holds its root's descendants, and the nodes of
+			// a class that reach back to its root form the root's component. Repeats, trimming
+			// first, until every node is assigned.
+			auto colour() -> void {
+				auto colours = std::vector<node_id>(component_.size());
+				auto const spread = [&](node_id u, std::vector<node_id>& next) {
+					auto const c = std::atomic_ref<node_id>(colours[u]).load(std::memory_order_relaxed);
+					for (auto const v : out_.out_edges(u)) {
+						if (is_unassigned(v) && raise(colours[v], c)) {
+							next.push_back(v);
+						}
+					}
+				};
+				auto const gather = [&](node_id u, std::vector<node_id>& next) {
+					for (auto const v : in_.out_edges(u)) {
+						if (colours[v] == colours[u] && claim(v, component_[u])) {
+							next.push_back(v);
+						}
+					}
+				};
+				for (;;) {
+					trim();
+					auto const remaining = unassigned_nodes();
+					if (remaining.empty()) {
+						return;
+					}
+					for (auto const u : remaining) {
+						colours[u] = u;
+					}
+					for (auto frontier = remaining; !frontier.empty();) {
+						frontier = parallel_expand(frontier, threads_, grain, spread);
+					}
+					// backward from every root at once, staying within each root's colour
+					auto frontier = std::vector<node_id>();
+					for (auto const u : remaining) {
+						if (colours[u] == u) {
+							component_[u] = next_label_.fetch_add(1, std::memory_order_relaxed);
+							frontier.push_back(u);
+						}
+					}
+					while (!frontier.empty()) {
+						frontier = parallel_expand(frontier, threads_, grain, gather);
+					}
+				}
+			}
+
+			// The labels found, renumbered densely in order of each component's lowest node so
+			// the result does not depend on thread timing.
+			auto result() && -> components {
+				// trimming can draw labels it then loses the race to use
+				auto renumber = std::vector<std::uint32_t>(next_label_, components::unassigned);
+				auto result = components{0, std::move(component_)};
+				for (auto& label : result.component) {
+					if (renumber[label] == components::unassigned) {
+						renumber[label] = result.count++;
+					}
+					label = renumber[label];
+				}
+				return result;
+			}
+
+		private:
+			auto unassigned_nodes() const -> std::vector<node_id> {
+				auto nodes = std::vector<node_id>();
+				for (auto v = node_id{0}; v < component_.size(); ++v) {
+					if (component_[v] == components::unassigned) {
+						nodes.push_back(v);
+					}
+				}
+				return nodes;
+			}
+
+			// atomic_ref cannot refer to const objects until C++26, so these are not const
+			auto is_unassigned(node_id v) noexcept -> bool {
+				auto const label = std::atomic_ref<std::uint32_t>(component_[v]);
+				return label.load(std::memory_order_relaxed) == components::unassigned;
+			}
+
+			// Gives v label if it is still unassigned, returning whether this call did.
+			auto claim(node_id v, std::uint32_t label) noexcept -> bool {
+				auto expected = components::unassigned;
+				return std::atomic_ref<std::uint32_t>(component_[v])
+				   .compare_exchange_strong(expected, label, std::memory_order_relaxed);
+			}
+
+			// Raises colour to at least c, returning whether it changed.
+			static auto raise(node_id& colour, node_id c) noexcept -> bool {
+				auto current = std::atomic_ref<node_id>(colour);
+				auto expected = current.load(std::memory_order_relaxed);
+				while (expected < c) {
+					if (current.compare_exchange_weak(expected, c, std::memory_order_relaxed)) {
+						return true;
+					}
+				}
+				return false;
+			}
+
+			// Whether u has no edges in side to unassigned nodes other than itself.
+			template<typename Side>
+			auto isolated(Side const& side, node_id u) noexcept -> bool {
+				auto const edges = side.out_edges(u);
+				return std::none_of(edges.begin(), edges.end(), [&](node_id v) {
+					return v != u && is_unassigned(v);
+				});
+			}
+
+			// Marks with to every unassigned node that side reaches from source through nodes
+			// marked with from.
+			template<typename Side>
+			auto reach(Side const& side,
+			           node_id source,
+			           std::vector<std::uint8_t>& mark,
+			           std::uint8_t from,
+			           std::uint8_t to) -> void {
+				mark[source] = to;
+				for (auto frontier = std::vector<node_id>{source}; !frontier.empty();) {
+					frontier = parallel_expand(frontier, threads_, grain, [&](node_id u, auto& next) {
+						for (auto const v : side.out_edges(u)) {
+							auto expected = from;
+							if (component_[v] == components::unassigned
+							    && std::atomic_ref<std::uint8_t>(mark[v])
+							          .compare_exchange_strong(expected, to, std::memory_order_relaxed))
+							{
+								next.push_back(v);
+							}
+						}
+					});
+				}
+			}
+
+			static constexpr auto grain = std::size_t{256};
+
+			G const& out_;
+			T const& in_;
+			unsigned threads_;
+			std::vector<std::uint32_t> component_;
+			std::atomic<std::uint32_t> next_label_ = 0;
+		};
+	} // namespace detail
+
+	// Strongly connected components in parallel. Nodes that cannot lie on a cycle are trimmed
+	// off first, then the component of a high-degree pivot is found by forward and backward
+	// reachability, and whatever remains is split by colouring (Hong et al.'s method). Each
+	// phase traverses level by level across threads. Components are labelled in order of their
+	// lowest node id. transpose must be g.transpose().
+	template<csr_view G, csr_view T>
+	auto parallel_scc(G const& g, T const& transpose, scc_options const& options = {})
+	   -> components {
+		auto const threads = options.threads == 0 ? detail::default_threads() : options.threads;
+		auto search = detail::parallel_scc_search<G, T>(g, transpose, threads);
+		search.trim();
+		search.forward_backward();
+		search.colour();
+		return std::move(search).result();
+	}
+
+	template<csr_view G>
+	auto parallel_scc(G const& g, scc_options const& options = {}) -> components {
+		return parallel_scc(g, g.transpose(), options);
+	}
+
+	// The strongly connected components of g, indexed by position in g.nodes() and labelled as
+	// tarjan_scc does.
+	template<typename N, typename E, typename Storage>
+	auto strongly_connected_components(graph<N, E, Storage> const& g) -> components {
+		return tarjan_scc(csr_graph<N, E>(g));
+	}
+
+	// The strongly connected components of g found in parallel, indexed by position in
+	// g.nodes() and labelled as parallel_scc does.
+	template<typename N, typename E, typename Storage>
+	auto strongly_connected_components(graph<N, E, Storage> const& g, scc_options const& options)
+	   -> components {
+		return parallel_scc(csr_graph<N, E>(g), options);
+	}
+} // namespace gdwg
+
+#endif // GDWG_ALGORITHM_SCC_HPP
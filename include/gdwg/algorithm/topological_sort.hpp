@@ -0,0 +1,195 @@
+#ifndef GDWG_ALGORITHM_TOPOLOGICAL_SORT_HPP
+#define GDWG_ALGORITHM_TOPOLOGICAL_SORT_HPP
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	struct topological_sort_options {
+		// 0 uses every hardware thread
+		unsigned threads = 0;
+	};
+
+	// A topological order, indexed by csr_graph node id, or by position in graph::nodes() for
+	// the graph overloads.
+	struct topological_order {
+		static constexpr auto unplaced = std::numeric_limits<std::uint32_t>::max();
+
+		// The nodes not on or after a cycle, each after all of its in-neighbours: level by level,
+		// and by id within a level.
+		std::vector<std::uint32_t> order;
+		// The number of edges on the longest path ending at each node, or unplaced. Nodes on one
+		// level have no path between them, so each level can be processed in parallel once the
+		// levels before it are done.
+		std::vector<std::uint32_t> level;
+		std::uint32_t level_count = 0;
+
+		// Whether every node was placed, which is when the graph has no cycles.
+		[[nodiscard]] auto acyclic() const noexcept -> bool {
+			return order.size() == level.size();
+		}
+	};
+
+	// Topological sort by Kahn's algorithm, one level at a time: every node whose in-edges all
+	// come from earlier levels forms the next level, and its out-edges are released across
+	// threads, each target counting down its remaining in-degree atomically. The result is the
+	// same for any number of threads. If g has a cycle, the nodes on it and every node reachable
+	// from it are left unplaced; find_cycle names one.
+	template<csr_view G>
+	auto topological_sort(G const& g, topological_sort_options const& options = {})
+	   -> topological_order {
+		using node_id = typename G::node_id;
+		constexpr auto grain = std::size_t{256};
+		auto const n = static_cast<std::size_t>(g.node_count());
+		auto const threads = options.threads == 0 ? detail::default_threads() : options.threads;
+		auto const offsets = g.offsets();
+		auto const targets = g.targets();
+
+		auto in_degree = std::vector<std::uint32_t>(n);
+		detail::parallel_for(n, threads, 4096, [&](unsigned, auto first, auto last) {
+			for (auto edge = offsets[first]; edge < offsets[last]; ++edge) {
+				std::atomic_ref<std::uint32_t>(in_degree[targets[edge]])
+				   .fetch_add(1, std::memory_order_relaxed);
+			}
+		});
+
+		auto result =
+		   topological_order{{}, std::vector<std::uint32_t>(n, topological_order::unplaced)};
+		auto frontier = std::vector<node_id>();
+		for (auto v = node_id{0}; v < n; ++v) {
+			if (in_degree[v] == 0) {
+				result.level[v] = 0;
+				frontier.push_back(v);
+			}
+		}
+		// the number of nodes on each level, for placing them below
+		auto sizes = std::vector<std::size_t>();
+		auto placed = std::size_t{0};
+		while (!frontier.empty()) {
+			auto const depth = static_cast<std::uint32_t>(sizes.size() + 1);
+			sizes.push_back(frontier.size());
+			placed += frontier.size();
+			// the edge that takes a target's count to 0 is its last from an earlier level, and
+			// only one thread can make that decrement
+			frontier = detail::parallel_expand(frontier, threads, grain, [&](node_id u, auto& next) {
+				for (auto const v : g.out_edges(u)) {
+					auto remaining = std::atomic_ref<std::uint32_t>(in_degree[v]);
+					if (remaining.fetch_sub(1, std::memory_order_relaxed) == 1) {
+						result.level[v] = depth;
+						next.push_back(v);
+					}
+				}
+			});
+		}
+		result.level_count = static_cast<std::uint32_t>(sizes.size());
+
+		// Each level comes out of the search in whatever order the threads reached it, so the
+		// order is rebuilt by a counting sort on level, which keeps ids ascending within each.
+		auto next_slot = std::vector<std::size_t>(sizes.size());
+		for (auto i = std::size_t{1}; i < sizes.size(); ++i) {
+			next_slot[i] = next_slot[i - 1] + sizes[i - 1];
+		}
+		result.order.resize(placed);
+		for (auto v = node_id{0}; v < n; ++v) {
+			if (result.level[v] != topological_order::unplaced) {
+				result.order[next_slot[result.level[v]]++] = v;
+			}
+		}
+		return result;
+	}
+
+	// A cycle in g, as its nodes in order, each with an edge to the next and the last with an
+	// edge to the first; a self-loop is a cycle of one node. Returns nullopt if g is acyclic.
+	// The depth-first search behind it stops at the first edge back onto its path, so a cycle
+	// near the start is found without looking at the rest of the graph. The search keeps its
+	// path on an explicit stack, so long paths cannot overflow the call stack.
+	template<csr_view G>
+	auto find_cycle(G const& g) -> std::optional<std::vector<typename G::node_id>> {
+		using node_id = typename G::node_id;
+		enum class state : std::uint8_t { unvisited, on_path, finished };
+		auto const n = static_cast<std::size_t>(g.node_count());
+		auto const offsets = g.offsets();
+		auto const targets = g.targets();
+
+		auto visited = std::vector<state>(n, state::unvisited);
+		// the search path, with the next out-edge each node on it will follow
+		auto path = std::vector<std::pair<node_id, std::size_t>>();
+		for (auto root = node_id{0}; root < n; ++root) {
+			if (visited[root] != state::unvisited) {
+				continue;
+			}
+			visited[root] = state::on_path;
+			path.emplace_back(root, offsets[root]);
+			while (!path.empty()) {
+				auto& [u, edge] = path.back();
+				if (edge == offsets[u + 1]) {
+					visited[u] = state::finished;
+					path.pop_back();
+					continue;
+				}
+				auto const v = targets[edge++];
+				if (visited[v] == state::unvisited) {
+					visited[v] = state::on_path;
+					path.emplace_back(v, offsets[v]); // invalidates u and edge
+				}
+				else if (visited[v] == state::on_path) {
+					// the cycle is the part of the path from v onwards
+					auto first = path.size() - 1;
+					while (path[first].first != v) {
+						--first;
+					}
+					auto cycle = std::vector<node_id>();
+					cycle.reserve(path.size() - first);
+					for (auto i = first; i < path.size(); ++i) {
+						cycle.push_back(path[i].first);
+					}
+					return cycle;
+				}
+			}
+		}
+		return std::nullopt;
+	}
+
+	template<csr_view G>
+	auto is_dag(G const& g) -> bool {
+		return !find_cycle(g).has_value();
+	}
+
+	// A topological order of g, indexed by position in g.nodes().
+	template<typename N, typename E, typename Storage>
+	auto topological_sort(graph<N, E, Storage> const& g,
+	                      topological_sort_options const& options = {}) -> topological_order {
+		return topological_sort(csr_graph<N, E>(g), options);
+	}
+
+	// A cycle in g as its nodes in order, or nullopt if g is acyclic.
+	template<typename N, typename E, typename Storage>
+	auto find_cycle(graph<N, E, Storage> const& g) -> std::optional<std::vector<N>> {
+		auto const snapshot = csr_graph<N, E>(g);
+		auto const ids = find_cycle(snapshot);
+		if (!ids) {
+			return std::nullopt;
+		}
+		auto cycle = std::vector<N>();
+		cycle.reserve(ids->size());
+		for (auto const id : *ids) {
+			cycle.push_back(snapshot.node(id));
+		}
+		return cycle;
+	}
+
+	template<typename N, typename E, typename Storage>
+	auto is_dag(graph<N, E, Storage> const& g) -> bool {
+		return is_dag(csr_graph<N, E>(g));
+	}
+} // namespace gdwg
+
+#endif // GDWG_ALGORITHM_TOPOLOGICAL_SORT_HPP
@@ -0,0 +1,289 @@
+#ifndef GDWG_ALGORITHM_WCC_HPP
+#define GDWG_ALGORITHM_WCC_HPP
+#include "gdwg/algorithm/components.hpp"
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/storage.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	struct wcc_options {
+		// 0 uses every hardware thread
+		unsigned threads = 0;
+		// How many of each node's edges to link before looking for the largest component, whose
+		// nodes then skip the rest of their out-edges.
+		std::uint32_t neighbour_rounds = 2;
+		// How many nodes to sample when looking for the largest component.
+		std::uint32_t samples = 1024;
+	};
+
+	namespace detail {
+		// A union-find forest that threads can link concurrently without locks. Roots are only
+		// ever linked under smaller roots, by compare-and-swap, so every parent is no larger
+		// than its child and each set's root is its smallest node.
+		class concurrent_union_find {
+		public:
+			explicit concurrent_union_find(std::size_t n)
+			: parent_(n) {
+				for (auto v = std::size_t{0}; v < n; ++v) {
+					parent_[v] = static_cast<std::uint32_t>(v);
+				}
+			}
+
+			// The root of v's set, halving the path to it on the way. Halving only writes to
+			// nodes that are already not roots, so it cannot undo a concurrent link.
+			auto find(std::uint32_t v) noexcept -> std::uint32_t {
+				for (;;) {
+					auto const parent = load(v);
+					auto const grandparent = load(parent);
+					if (parent == grandparent) {
+						return parent;
+					}
+					store(v, grandparent);
+					v = grandparent;
+				}
+			}
+
+			auto link(std::uint32_t u, std::uint32_t v) noexcept -> void {
+				for (;;) {
+					auto ru = find(u);
+					auto rv = find(v);
+					if (ru == rv) {
+						return;
+					}
+					if (ru < rv) {
+						std::swap(ru, rv);
+					}
+					// ru may have been linked since find returned it; if so, try again
+					auto expected = ru;
+					if (std::atomic_ref<std::uint32_t>(parent_[ru])
+					       .compare_exchange_strong(expected, rv, std::memory_order_relaxed))
+					{
+						return;
+					}
+				}
+			}
+
+			// Points every node straight at its root. Must not run alongside link, though threads
+			// still find through each other's nodes while it runs.
+			auto compress(unsigned threads) -> void {
+				parallel_for(parent_.size(), threads, 4096, [this](unsigned, auto first, auto last) {
+					for (auto v = first; v < last; ++v) {
+						auto const node = static_cast<std::uint32_t>(v);
+						store(node, find(node));
+					}
+				});
+			}
+
+			// Dense labels in order of each set's smallest node. Must follow compress.
+			auto labels() && -> components {
+				auto result = components{0, std::move(parent_)};
+				for (auto v = std::size_t{0}; v < result.component.size(); ++v) {
+					auto const root = result.component[v];
+					// roots come before the rest of their set, so they are relabelled first
+					result.component[v] = root == v ? result.count++ : result.component[root];
+				}
+				return result;
+			}
+
+		private:
+			auto load(std::uint32_t v) noexcept -> std::uint32_t {
+				return std::atomic_ref<std::uint32_t>(parent_[v]).load(std::memory_order_relaxed);
+			}
+
+			auto store(std::uint32_t v, std::uint32_t parent) noexcept -> void {
+				std::atomic_ref<std::uint32_t>(parent_[v]).store(parent, std::memory_order_relaxed);
+			}
+
+			std::vector<std::uint32_t> parent_;
+		};
+	} // namespace detail
+
+	// Weakly connected components, treating every edge as undirected, by Afforest (Sutton et
+	// al.). Threads first link each node to a few of its neighbours, which is usually enough to
+	// gather most of the largest component. That component is found by sampling, and its nodes
+	// skip their remaining edges: any edge joining it to another node is still seen from the
+	// other end, through the other node's out-edges or, via transpose, its in-edges. Components
+	// are labelled in order of their lowest node id. transpose must be g.transpose().
+	template<csr_view G, csr_view T>
+	auto weakly_connected_components(G const& g, T const& transpose, wcc_options const& options = {})
+	   -> components {
+		using node_id = typename G::node_id;
+		auto const n = static_cast<std::size_t>(g.node_count());
+		auto const threads = options.threads == 0 ? detail::default_threads() : options.threads;
+		auto const offsets = g.offsets();
+		auto const targets = g.targets();
+		auto forest = detail::concurrent_union_find(n);
+
+		for (auto round = std::size_t{0}; round < options.neighbour_rounds; ++round) {
+			detail::parallel_for(n, threads, 4096, [&](unsigned, auto first, auto last) {
+				for (auto u = first; u < last; ++u) {
+					if (offsets[u] + round < offsets[u + 1]) {
+						forest.link(static_cast<node_id>(u), targets[offsets[u] + round]);
+					}
+				}
+			});
+		}
+		forest.compress(threads);
+
+		// the most common root among evenly spread samples
+		auto largest = components::unassigned;
+		if (n > 0) {
+			auto counts = std::map<std::uint32_t, std::uint32_t>();
+			auto const samples = std::max<std::size_t>(1, options.samples);
+			for (auto i = std::size_t{0}; i < samples; ++i) {
+				++counts[forest.find(static_cast<node_id>(i * n / samples))];
+			}
+			largest = std::max_element(counts.begin(), counts.end(), [](auto const& a, auto const& b) {
+				          return a.second < b.second;
+			          })->first;
+		}
+
+		detail::parallel_for(n, threads, 1024, [&](unsigned, auto first, auto last) {
+			for (auto u = static_cast<node_id>(first); u < last; ++u) {
+				if (forest.find(u) == largest) {
+					continue;
+				}
+				for (auto edge = offsets[u] + options.neighbour_rounds; edge < offsets[u + 1]; ++edge) {
+					forest.link(u, targets[edge]);
+				}
+				for (auto const v : transpose.out_edges(u)) {
+					forest.link(u, v);
+				}
+			}
+		});
+		forest.compress(threads);
+		return std::move(forest).labels();
+	}
+
+	template<csr_view G>
+	auto weakly_connected_components(G const& g, wcc_options const& options = {}) -> components {
+		return weakly_connected_components(g, g.transpose(), options);
+	}
+
+	// The weakly connected components of g, indexed by position in g.nodes().
+	template<typename N, typename E, typename Storage>
+	auto weakly_connected_components(graph<N, E, Storage> const& g, wcc_options const& options = {})
+	   -> components {
+		return weakly_connected_components(csr_graph<N, E>(g), options);
+	}
+
+	// Weakly connected components kept up to date as nodes and edges are added, so that asking
+	// whether two nodes are connected costs two node lookups and two finds instead of a
+	// traversal. It is a separate object, not a view of a graph: it only learns of the
+	// insert_node and insert_edge calls it is given, so the caller must make the same calls on
+	// it as on the graph it mirrors, or build it from the graph. A missed call leaves it
+	// silently out of date, and since union-find cannot split a component, so does any erase
+	// from the graph; build a new one after erasing.
+	// Nodes are looked up in Storage's node table, which costs O(log n) per lookup with
+	// ordered_storage and expected O(1) with hashed_storage. insert_edge halves the paths it
+	// walks, keeping finds near constant, while the const queries only read, so a find there
+	// costs at most O(log n) and any number of threads may query at once. Inserts need
+	// exclusive access.
+	template<typename N, typename Storage = ordered_storage>
+	class incremental_components {
+	public:
+		incremental_components() = default;
+
+		template<typename E, typename GraphStorage>
+		explicit incremental_components(graph<N, E, GraphStorage> const& g) {
+			for (auto const& value : g.nodes()) {
+				insert_node(value);
+			}
+			for (auto const& [from, to, weight] : g) {
+				insert_edge(from, to);
+			}
+		}
+
+		// Adds value as a component of its own, returning false if it is already present.
+		auto insert_node(N const& value) -> bool {
+			auto const id = static_cast<std::uint32_t>(parent_.size());
+			auto const [it, inserted] = ids_.emplace(value, id);
+			if (inserted) {
+				parent_.push_back(id);
+				size_.push_back(1);
+				++count_;
+			}
+			return inserted;
+		}
+
+		// Joins the components of src and dst, returning whether they were separate.
+		auto insert_edge(N const& src, N const& dst) -> bool {
+			auto a = compress(checked_id(src, "insert_edge"));
+			auto b = compress(checked_id(dst, "insert_edge"));
+			if (a == b) {
+				return false;
+			}
+			// the smaller tree goes under the larger, keeping every path O(log n) long
+			if (size_[a] < size_[b]) {
+				std::swap(a, b);
+			}
+			parent_[b] = a;
+			size_[a] += size_[b];
+			--count_;
+			return true;
+		}
+
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return ids_.find(value) != ids_.end();
+		}
+
+		[[nodiscard]] auto connected(N const& a, N const& b) const -> bool {
+			return find(checked_id(a, "connected")) == find(checked_id(b, "connected"));
+		}
+
+		// The number of nodes in value's component.
+		[[nodiscard]] auto component_size(N const& value) const -> std::size_t {
+			return size_[find(checked_id(value, "component_size"))];
+		}
+
+		[[nodiscard]] auto component_count() const noexcept -> std::size_t {
+			return count_;
+		}
+
+	private:
+		auto checked_id(N const& value, char const* function) const -> std::uint32_t {
+			auto const it = ids_.find(value);
+			if (it == ids_.end()) {
+				throw std::runtime_error(std::string("Cannot call gdwg::incremental_components<N>::")
+				                         + function + " on a node that doesn't exist");
+			}
+			return it->second;
+		}
+
+		// The root of v's tree. Doesn't write, so const queries can run concurrently; union by
+		// size keeps the walk O(log n) long.
+		auto find(std::uint32_t v) const noexcept -> std::uint32_t {
+			while (parent_[v] != v) {
+				v = parent_[v];
+			}
+			return v;
+		}
+
+		// find, halving the path on the way up so later walks are shorter.
+		auto compress(std::uint32_t v) noexcept -> std::uint32_t {
+			while (parent_[v] != v) {
+				parent_[v] = parent_[parent_[v]];
+				v = parent_[v];
+			}
+			return v;
+		}
+
+		typename Storage::template node_map<N, std::uint32_t> ids_;
+		std::vector<std::uint32_t> parent_;
+		std::vector<std::size_t> size_;
+		std::size_t count_ = 0;
+	};
+} // namespace gdwg
+
+#endif // GDWG_ALGORITHM_WCC_HPP
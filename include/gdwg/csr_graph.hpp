@@ -0,0 +1,449 @@
+#ifndef GDWG_CSR_GRAPH_HPP
+#define GDWG_CSR_GRAPH_HPP
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// The dense id interface the algorithms read a graph through: node ids 0 to node_count(),
+	// with the edges of node u at targets()[offsets()[u], offsets()[u + 1]) and the matching
+	// entries of edge_weights(), ordered by destination then weight. csr_graph provides it, and
+	// so does mapped_graph over a snapshot file.
+	template<typename G>
+	concept csr_view =
+	   std::same_as<typename G::node_id, std::uint32_t>
+	   && requires(G const& g, typename G::node_id u) {
+		     typename G::node_type;
+		     typename G::weight_type;
+		     { g.node_count() } -> std::same_as<typename G::node_id>;
+		     { g.edge_count() } -> std::same_as<std::size_t>;
+		     { g.offsets() } -> std::ranges::random_access_range;
+		     { g.targets() } -> std::same_as<std::span<typename G::node_id const>>;
+		     { g.edge_weights() } -> std::same_as<std::span<typename G::weight_type const>>;
+		     { g.out_degree(u) } -> std::same_as<std::size_t>;
+		     { g.out_edges(u) } -> std::same_as<std::span<typename G::node_id const>>;
+		     { g.out_weights(u) } -> std::same_as<std::span<typename G::weight_type const>>;
+	     };
+
+	// A read-only snapshot of a graph in compressed sparse row form.
+	// Nodes are given dense ids in ascending order, so id order matches the node order of the
+	// graph it was built from. The edges of node u are
+	// targets()[offsets()[u], offsets()[u + 1]) with the matching entries of edge_weights(), and
+	// are ordered by destination then weight just like graph.
+	template<typename N, typename E>
+	class csr_graph {
+	public:
+		using node_id = std::uint32_t;
+		using node_type = N;
+		using weight_type = E;
+
+	private:
+		struct value_type {
+			N from;
+			N to;
+			E weight;
+		};
+		// Refers into the snapshot's arrays, like graph's iterator reference.
+		struct edge_reference {
+			N const& from;
+			N const& to;
+			E const& weight;
+
+			operator value_type() const {
+				return value_type{from, to, weight};
+			}
+		};
+		struct edge_pointer {
+			edge_reference ref;
+
+			auto operator->() const noexcept -> edge_reference const* {
+				return &ref;
+			}
+		};
+		class iterator {
+		public:
+			using value_type = csr_graph<N, E>::value_type;
+			using reference = edge_reference;
+			using pointer = edge_pointer;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			// Iterator constructor
+			explicit iterator() = default;
+
+			explicit iterator(csr_graph const* g, node_id src, std::size_t edge)
+			: graph_(g)
+			, src_(src)
+			, edge_(edge) {}
+
+			// Iterator source
+			auto operator*() const noexcept -> reference {
+				return reference{graph_->nodes_[src_],
+				                 graph_->nodes_[graph_->targets_[edge_]],
+				                 graph_->weights_[edge_]};
+			}
+			auto operator->() const noexcept -> pointer {
+				return pointer{**this};
+			}
+
+			// Iterator traversal
+			auto operator++() -> iterator& {
+				++edge_;
+				// skips nodes with no edges
+				while (src_ < graph_->node_count() && edge_ == graph_->offsets_[src_ + 1]) {
+					++src_;
+				}
+				return *this;
+			}
+			auto operator++(int) -> iterator {
+				auto ret = *this;
+				++*this;
+				return ret;
+			}
+			auto operator--() -> iterator& {
+				--edge_;
+				// skips nodes with no edges
+				while (edge_ < graph_->offsets_[src_]) {
+					--src_;
+				}
+				return *this;
+			}
+			auto operator--(int) -> iterator {
+				auto ret = *this;
+				--*this;
+				return ret;
+			}
+
+			// Iterator comparison
+			auto operator==(iterator const& other) const -> bool {
+				return edge_ == other.edge_;
+			}
+
+		private:
+			csr_graph const* graph_ = nullptr;
+			node_id src_ = 0;
+			std::size_t edge_ = 0;
+		};
+
+	public:
+		// Iterator
+		using iterator = csr_graph<N, E>::iterator;
+		using const_iterator = const csr_graph<N, E>::iterator;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		[[nodiscard]] auto begin() const noexcept -> iterator {
+			auto src = node_id{0};
+			while (src < node_count() && offsets_[src + 1] == 0) {
+				++src;
+			}
+			return iterator(this, src, 0);
+		}
+		[[nodiscard]] auto end() const noexcept -> iterator {
+			return iterator(this, node_count(), edge_count());
+		}
+		auto cbegin() const noexcept -> const_iterator {
+			return begin();
+		}
+		auto cend() const noexcept -> const_iterator {
+			return end();
+		}
+
+		// Constructors
+		csr_graph()
+		: offsets_{0} {}
+
+		// Snapshots g. With an ordered node table its iterator already walks the edges in
+		// (src, dst, weight) order, so the arrays are filled in a single pass.
+		template<typename Storage>
+		explicit csr_graph(graph<N, E, Storage> const& g)
+		: nodes_(g.nodes()) {
+			if (nodes_.size() > std::numeric_limits<node_id>::max()) {
+				throw std::length_error("Cannot build gdwg::csr_graph<N, E> with more nodes than "
+				                        "node_id can index");
+			}
+			if constexpr (Storage::ordered) {
+				offsets_.reserve(nodes_.size() + 1);
+				offsets_.push_back(0);
+				for (auto const& [from, to, weight] : g) {
+					// close off every node up to and including the previous source
+					while (!(nodes_[offsets_.size() - 1] == from)) {
+						offsets_.push_back(targets_.size());
+					}
+					targets_.push_back(*id(to));
+					weights_.push_back(weight);
+				}
+				while (offsets_.size() < nodes_.size() + 1) {
+					offsets_.push_back(targets_.size());
+				}
+				targets_.shrink_to_fit();
+				weights_.shrink_to_fit();
+			}
+			else {
+				// sources come out in table order, so count each node's edges before placing them.
+				// Edges of one source are still consecutive and sorted.
+				offsets_.assign(nodes_.size() + 1, 0);
+				for (auto const& [from, to, weight] : g) {
+					++offsets_[*id(from) + 1];
+				}
+				std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+				targets_.resize(offsets_.back());
+				weights_.resize(offsets_.back());
+				auto next = std::vector<std::size_t>(offsets_.begin(), offsets_.end() - 1);
+				for (auto const& [from, to, weight] : g) {
+					auto const slot = next[*id(from)]++;
+					targets_[slot] = *id(to);
+					weights_[slot] = weight;
+				}
+			}
+		}
+
+		// Builds a snapshot of the graph with the given nodes and {src, dst, weight} edges without
+		// going through graph, which suits edge lists too large to hold as one. The edges are read
+		// twice, to count and then to place them. Repeated edges are kept once, as graph would.
+		template<std::forward_iterator ForwardIt>
+		csr_graph(std::vector<N> nodes, ForwardIt first, ForwardIt last)
+		: nodes_(std::move(nodes)) {
+			std::sort(nodes_.begin(), nodes_.end());
+			nodes_.erase(std::unique(nodes_.begin(), nodes_.end()), nodes_.end());
+			if (nodes_.size() > std::numeric_limits<node_id>::max()) {
+				throw std::length_error("Cannot build gdwg::csr_graph<N, E> with more nodes than "
+				                        "node_id can index");
+			}
+			auto const checked_id = [this](auto const& value) {
+				auto const result = id(static_cast<N>(value));
+				if (!result) {
+					throw std::runtime_error("Cannot build gdwg::csr_graph<N, E> from an edge whose src "
+					                         "or dst node is not in the graph");
+				}
+				return *result;
+			};
+			offsets_.assign(nodes_.size() + 1, 0);
+			for (auto it = first; it != last; ++it) {
+				auto const& [src, dst, weight] = *it;
+				checked_id(dst);
+				++offsets_[checked_id(src) + 1];
+			}
+			std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+			auto edges = std::vector<std::pair<node_id, E>>(offsets_.back());
+			auto next = std::vector<std::size_t>(offsets_.begin(), offsets_.end() - 1);
+			for (auto it = first; it != last; ++it) {
+				auto const& [src, dst, weight] = *it;
+				edges[next[checked_id(src)]++] = {checked_id(dst), static_cast<E>(weight)};
+			}
+			// sort each node's edges and drop repeats, closing up the gaps they leave
+			targets_.reserve(edges.size());
+			weights_.reserve(edges.size());
+			for (auto u = std::size_t{0}; u < nodes_.size(); ++u) {
+				auto const row_first = edges.begin() + static_cast<std::ptrdiff_t>(offsets_[u]);
+				auto const row_last = edges.begin() + static_cast<std::ptrdiff_t>(offsets_[u + 1]);
+				std::sort(row_first, row_last);
+				offsets_[u] = targets_.size();
+				for (auto edge = row_first; edge != row_last; ++edge) {
+					if (edge == row_first || !(*edge == *std::prev(edge))) {
+						targets_.push_back(edge->first);
+						weights_.push_back(edge->second);
+					}
+				}
+			}
+			offsets_.back() = targets_.size();
+			targets_.shrink_to_fit();
+			weights_.shrink_to_fit();
+		}
+
+		// Snapshots a synthetic graph from generators.hpp straight from its edge stream, over the
+		// nodes N(0) ... N(node_count - 1) and with each weight converted to E, without building a
+		// graph first.
+		template<typename Generator>
+		   requires std::ranges::forward_range<Generator const> && requires(Generator const& g) {
+			   { g.node_count() } -> std::convertible_to<std::uint64_t>;
+		   }
+		[[nodiscard]] static auto from_generator(Generator const& generator) -> csr_graph {
+			auto nodes = std::vector<N>();
+			nodes.reserve(static_cast<std::size_t>(generator.node_count()));
+			for (auto node = std::uint64_t{0}; node < generator.node_count(); ++node) {
+				nodes.push_back(static_cast<N>(node));
+			}
+			return csr_graph(std::move(nodes),
+			                 std::ranges::begin(generator),
+			                 std::ranges::end(generator));
+		}
+
+		// Builds the snapshot with every edge reversed, so the edges of node v are its incoming
+		// edges ordered by source then weight.
+		[[nodiscard]] auto transpose() const -> csr_graph {
+			return transpose_of(*this);
+		}
+
+		// Builds the transpose of another view of a graph with the same node and weight types,
+		// such as a mapped_graph, as a snapshot of its own.
+		template<csr_view G>
+		   requires std::same_as<typename G::node_type, N> && std::same_as<typename G::weight_type, E>
+		[[nodiscard]] static auto transpose_of(G const& g) -> csr_graph {
+			auto result = csr_graph();
+			result.nodes_.reserve(g.node_count());
+			for (auto u = node_id{0}; u < g.node_count(); ++u) {
+				result.nodes_.emplace_back(g.node(u));
+			}
+			result.offsets_.assign(result.nodes_.size() + 1, 0);
+			auto const targets = g.targets();
+			auto const weights = g.edge_weights();
+			for (auto const dst : targets) {
+				++result.offsets_[dst + 1];
+			}
+			std::partial_sum(result.offsets_.begin(), result.offsets_.end(), result.offsets_.begin());
+			result.targets_.resize(targets.size());
+			result.weights_.resize(weights.size());
+			auto next = std::vector<std::size_t>(result.offsets_.begin(), result.offsets_.end() - 1);
+			auto const offsets = g.offsets();
+			// sources are visited in ascending order so each incoming list comes out sorted
+			for (auto src = node_id{0}; src < g.node_count(); ++src) {
+				for (auto e = offsets[src]; e < offsets[src + 1]; ++e) {
+					auto const slot = next[targets[e]]++;
+					result.targets_[slot] = src;
+					result.weights_[slot] = weights[e];
+				}
+			}
+			return result;
+		}
+
+		// Accessors
+		[[nodiscard]] auto is_node(N const& value) const noexcept -> bool {
+			return id(value).has_value();
+		}
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return nodes_.empty();
+		}
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			auto const [src_id, dst_id] = checked_ids(src, dst, "is_connected");
+			auto const out = out_edges(src_id);
+			return std::binary_search(out.begin(), out.end(), dst_id);
+		}
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return nodes_;
+		}
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			auto const view = weights_view(src, dst);
+			return std::vector<E>(view.begin(), view.end());
+		}
+		// The weights of the edges from src to dst in ascending order, without copying them.
+		[[nodiscard]] auto weights_view(N const& src, N const& dst) const -> std::span<E const> {
+			auto const [src_id, dst_id] = checked_ids(src, dst, "weights");
+			auto const [first, last] = edge_range(src_id, dst_id);
+			return std::span<E const>(weights_).subspan(first, last - first);
+		}
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const noexcept
+		   -> iterator {
+			auto const src_id = id(src);
+			auto const dst_id = id(dst);
+			if (!src_id || !dst_id) {
+				return end();
+			}
+			auto const [first, last] = edge_range(*src_id, *dst_id);
+			auto const edge = std::lower_bound(weights_.begin() + static_cast<std::ptrdiff_t>(first),
+			                                   weights_.begin() + static_cast<std::ptrdiff_t>(last),
+			                                   weight);
+			auto const index = static_cast<std::size_t>(edge - weights_.begin());
+			if (index == last || !(*edge == weight)) {
+				return end();
+			}
+			return iterator(this, *src_id, index);
+		}
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto const src_id = id(src);
+			if (!src_id) {
+				throw std::runtime_error("Cannot call gdwg::csr_graph<N, E>::connections if src "
+				                         "doesn't exist in the graph");
+			}
+			auto result = std::vector<N>();
+			auto const out = out_edges(*src_id);
+			for (auto it = out.begin(); it != out.end(); it = std::upper_bound(it, out.end(), *it)) {
+				result.push_back(nodes_[*it]);
+			}
+			return result;
+		}
+
+		// Dense id accessors
+		[[nodiscard]] auto node_count() const noexcept -> node_id {
+			return static_cast<node_id>(nodes_.size());
+		}
+		[[nodiscard]] auto edge_count() const noexcept -> std::size_t {
+			return targets_.size();
+		}
+		[[nodiscard]] auto id(N const& value) const noexcept -> std::optional<node_id> {
+			auto const it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			if (it == nodes_.end() || !(*it == value)) {
+				return std::nullopt;
+			}
+			return static_cast<node_id>(it - nodes_.begin());
+		}
+		[[nodiscard]] auto node(node_id u) const noexcept -> N const& {
+			return nodes_[u];
+		}
+		[[nodiscard]] auto out_degree(node_id u) const noexcept -> std::size_t {
+			return offsets_[u + 1] - offsets_[u];
+		}
+		[[nodiscard]] auto out_edges(node_id u) const noexcept -> std::span<node_id const> {
+			return std::span<node_id const>(targets_).subspan(offsets_[u], out_degree(u));
+		}
+		[[nodiscard]] auto out_weights(node_id u) const noexcept -> std::span<E const> {
+			return std::span<E const>(weights_).subspan(offsets_[u], out_degree(u));
+		}
+		[[nodiscard]] auto offsets() const noexcept -> std::span<std::size_t const> {
+			return offsets_;
+		}
+		[[nodiscard]] auto targets() const noexcept -> std::span<node_id const> {
+			return targets_;
+		}
+		[[nodiscard]] auto edge_weights() const noexcept -> std::span<E const> {
+			return weights_;
+		}
+
+		// Comparisons
+		[[nodiscard]] auto operator==(csr_graph const& other) const -> bool = default;
+
+	private:
+		// Looks up both endpoints, throwing with the same wording graph uses when either is missing.
+		auto checked_ids(N const& src, N const& dst, char const* function) const
+		   -> std::pair<node_id, node_id> {
+			auto const src_id = id(src);
+			auto const dst_id = id(dst);
+			if (!src_id || !dst_id) {
+				throw std::runtime_error(std::string("Cannot call gdwg::csr_graph<N, E>::") + function
+				                         + " if src or dst node don't exist in the graph");
+			}
+			return {*src_id, *dst_id};
+		}
+
+		// The [first, last) positions of the edges from src to dst.
+		auto edge_range(node_id src, node_id dst) const -> std::pair<std::size_t, std::size_t> {
+			auto const out = out_edges(src);
+			auto const [first, last] = std::equal_range(out.begin(), out.end(), dst);
+			return {offsets_[src] + static_cast<std::size_t>(first - out.begin()),
+			        offsets_[src] + static_cast<std::size_t>(last - out.begin())};
+		}
+
+		// internal structure
+		std::vector<N> nodes_;
+		std::vector<std::size_t> offsets_;
+		std::vector<node_id> targets_;
+		std::vector<E> weights_;
+	};
+
+} // namespace gdwg
+
+#endif // GDWG_CSR_GRAPH_HPP
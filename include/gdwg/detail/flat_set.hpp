@@ -0,0 +1,188 @@
+#ifndef GDWG_DETAIL_FLAT_SET_HPP
+#define GDWG_DETAIL_FLAT_SET_HPP
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace gdwg::detail {
+	// A set kept as a sorted std::vector. It provides the subset of the std::set interface that
+	// graph uses, with contiguous storage and no per-element allocation. Insertion and erasure are
+	// O(size) moves, so it suits adjacency lists that are read far more often than they change.
+	template<typename Key, typename Compare = std::less<Key>>
+	class flat_set {
+		using container_type = std::vector<Key>;
+
+	public:
+		using key_type = Key;
+		using value_type = Key;
+		using key_compare = Compare;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using iterator = typename container_type::const_iterator;
+		using const_iterator = iterator;
+
+		// Constructors
+		flat_set() = default;
+		explicit flat_set(Compare const& comp)
+		: comp_(comp) {}
+		template<typename InputIt>
+		flat_set(InputIt first, InputIt last, Compare const& comp = Compare())
+		: data_(first, last)
+		, comp_(comp) {
+			std::sort(data_.begin(), data_.end(), comp_);
+			auto const equivalent = [this](Key const& lhs, Key const& rhs) {
+				return !comp_(lhs, rhs) && !comp_(rhs, lhs);
+			};
+			data_.erase(std::unique(data_.begin(), data_.end(), equivalent), data_.end());
+		}
+
+		// Iterators
+		[[nodiscard]] auto begin() const noexcept -> const_iterator {
+			return data_.cbegin();
+		}
+		[[nodiscard]] auto end() const noexcept -> const_iterator {
+			return data_.cend();
+		}
+		[[nodiscard]] auto cbegin() const noexcept -> const_iterator {
+			return data_.cbegin();
+		}
+		[[nodiscard]] auto cend() const noexcept -> const_iterator {
+			return data_.cend();
+		}
+
+		// Capacity
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return data_.empty();
+		}
+		[[nodiscard]] auto size() const noexcept -> size_type {
+			return data_.size();
+		}
+		auto reserve(size_type n) -> void {
+			data_.reserve(n);
+		}
+
+		// Modifiers
+		template<typename... Args>
+		auto emplace(Args&&... args) -> std::pair<iterator, bool> {
+			return insert(Key(std::forward<Args>(args)...));
+		}
+		auto insert(Key value) -> std::pair<iterator, bool> {
+			auto const it = lower_bound(value);
+			if (it != end() && !comp_(value, *it)) {
+				return {it, false};
+			}
+			return {data_.insert(it, std::move(value)), true};
+		}
+		// Inserts value just before hint when that keeps the set ordered, which makes appending
+		// sorted input O(1) amortised.
+		auto insert(const_iterator hint, Key value) -> iterator {
+			if ((hint == end() || comp_(value, *hint))
+			    && (hint == begin() || comp_(*std::prev(hint), value))) {
+				return data_.insert(hint, std::move(value));
+			}
+			return insert(std::move(value)).first;
+		}
+		// Appends [first, last) and merges it in, so a batch of k insertions costs one
+		// O(size + k log k) pass rather than k O(size) shifts.
+		template<typename InputIt>
+		auto insert(InputIt first, InputIt last) -> void {
+			auto const old_size = static_cast<difference_type>(data_.size());
+			data_.insert(data_.end(), first, last);
+			auto const middle = data_.begin() + old_size;
+			std::sort(middle, data_.end(), comp_);
+			std::inplace_merge(data_.begin(), middle, data_.end(), comp_);
+			// the merge is stable, so elements already in the set win over new equivalents
+			auto const equivalent = [this](Key const& lhs, Key const& rhs) {
+				return !comp_(lhs, rhs) && !comp_(rhs, lhs);
+			};
+			data_.erase(std::unique(data_.begin(), data_.end(), equivalent), data_.end());
+		}
+		// Erases [erase_first, erase_last), every element of which is in the set, and merges in
+		// [insert_first, insert_last), none of which is, both sorted. What is kept is moved to a
+		// new vector and the new elements merged into it, so the whole change costs one
+		// O(size + k) pass rather than an O(size) shift per erased element.
+		template<typename EraseIt, typename InsertIt>
+		auto replace(EraseIt erase_first,
+		             EraseIt erase_last,
+		             InsertIt insert_first,
+		             InsertIt insert_last) -> void {
+			auto const inserted = static_cast<size_type>(std::distance(insert_first, insert_last));
+			auto result = container_type();
+			result.reserve(data_.size() + inserted);
+			std::set_difference(std::make_move_iterator(data_.begin()),
+			                    std::make_move_iterator(data_.end()),
+			                    erase_first,
+			                    erase_last,
+			                    std::back_inserter(result),
+			                    comp_);
+			auto const kept = static_cast<difference_type>(result.size());
+			result.insert(result.end(), insert_first, insert_last);
+			std::inplace_merge(result.begin(), result.begin() + kept, result.end(), comp_);
+			data_ = std::move(result);
+		}
+		auto erase(const_iterator pos) -> iterator {
+			return data_.erase(pos);
+		}
+		auto erase(const_iterator first, const_iterator last) -> iterator {
+			return data_.erase(first, last);
+		}
+		template<typename K>
+		auto erase(K const& key) -> size_type {
+			auto const [first, last] = equal_range(key);
+			auto const count = static_cast<size_type>(last - first);
+			data_.erase(first, last);
+			return count;
+		}
+		auto clear() noexcept -> void {
+			data_.clear();
+		}
+
+		// Lookup
+		template<typename K>
+		[[nodiscard]] auto find(K const& key) const -> const_iterator {
+			auto const it = lower_bound(key);
+			return it != end() && !comp_(key, *it) ? it : end();
+		}
+		template<typename K>
+		[[nodiscard]] auto contains(K const& key) const -> bool {
+			return find(key) != end();
+		}
+		template<typename K>
+		[[nodiscard]] auto count(K const& key) const -> size_type {
+			auto const [first, last] = equal_range(key);
+			return static_cast<size_type>(last - first);
+		}
+		template<typename K>
+		[[nodiscard]] auto lower_bound(K const& key) const -> const_iterator {
+			return std::lower_bound(begin(), end(), key, comp_);
+		}
+		template<typename K>
+		[[nodiscard]] auto upper_bound(K const& key) const -> const_iterator {
+			return std::upper_bound(begin(), end(), key, comp_);
+		}
+		template<typename K>
+		[[nodiscard]] auto equal_range(K const& key) const
+		   -> std::pair<const_iterator, const_iterator> {
+			return std::equal_range(begin(), end(), key, comp_);
+		}
+
+		// Observers
+		[[nodiscard]] auto key_comp() const -> key_compare {
+			return comp_;
+		}
+
+		// Comparisons
+		[[nodiscard]] auto operator==(flat_set const& other) const -> bool {
+			return data_ == other.data_;
+		}
+
+	private:
+		container_type data_;
+		[[no_unique_address]] Compare comp_;
+	};
+} // namespace gdwg::detail
+
+#endif // GDWG_DETAIL_FLAT_SET_HPP
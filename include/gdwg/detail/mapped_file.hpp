@@ -0,0 +1,84 @@
+#ifndef GDWG_DETAIL_MAPPED_FILE_HPP
+#define GDWG_DETAIL_MAPPED_FILE_HPP
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gdwg::detail {
+	// A whole file mapped read-only into memory. Nothing is read until a page is first touched,
+	// so mapping costs the same for any file size. The mapping outlives the file descriptor,
+	// which is closed straight away.
+	class mapped_file {
+	public:
+		// what names the caller in error messages, such as "gdwg::mapped_graph<N, E>"
+		mapped_file(std::filesystem::path const& path, char const* what) {
+			auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd == -1) {
+				throw std::runtime_error(std::string("Cannot load ") + what
+				                         + " from a file that can't be opened");
+			}
+			struct ::stat status = {};
+			if (::fstat(fd, &status) == -1) {
+				::close(fd);
+				throw std::runtime_error(std::string("Cannot load ") + what
+				                         + " from a file whose size can't be read");
+			}
+			size_ = static_cast<std::size_t>(status.st_size);
+			if (size_ > 0) {
+				auto* const data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (data == MAP_FAILED) {
+					::close(fd);
+					throw std::runtime_error(std::string("Cannot load ") + what
+					                         + " from a file that can't be mapped");
+				}
+				data_ = static_cast<std::byte const*>(data);
+			}
+			::close(fd);
+		}
+
+		mapped_file(mapped_file&& other) noexcept
+		: data_(std::exchange(other.data_, nullptr))
+		, size_(std::exchange(other.size_, 0)) {}
+
+		auto operator=(mapped_file&& other) noexcept -> mapped_file& {
+			if (this != &other) {
+				unmap();
+				data_ = std::exchange(other.data_, nullptr);
+				size_ = std::exchange(other.size_, 0);
+			}
+			return *this;
+		}
+
+		mapped_file(mapped_file const&) = delete;
+		auto operator=(mapped_file const&) -> mapped_file& = delete;
+
+		~mapped_file() {
+			unmap();
+		}
+
+		// Page-aligned, so any section starting at a suitably aligned offset is aligned too.
+		[[nodiscard]] auto bytes() const noexcept -> std::span<std::byte const> {
+			return {data_, size_};
+		}
+
+	private:
+		auto unmap() noexcept -> void {
+			if (data_ != nullptr) {
+				::munmap(const_cast<std::byte*>(data_), size_);
+			}
+		}
+
+		std::byte const* data_ = nullptr;
+		std::size_t size_ = 0;
+	};
+} // namespace gdwg::detail
+
+#endif // GDWG_DETAIL_MAPPED_FILE_HPP
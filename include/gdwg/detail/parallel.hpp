@@ -0,0 +1,149 @@
+#ifndef GDWG_DETAIL_PARALLEL_HPP
+#define GDWG_DETAIL_PARALLEL_HPP
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace gdwg::detail {
+	// The number of threads an algorithm uses when it is asked for 0.
+	inline auto default_threads() noexcept -> unsigned {
+		return std::max(1U, std::thread::hardware_concurrency());
+	}
+
+	// The number of threads parallel_for would use for n items.
+	inline auto parallel_threads(std::size_t n, unsigned threads, std::size_t grain) noexcept
+	   -> unsigned {
+		auto const chunks = (n + grain - 1) / grain;
+		return static_cast<unsigned>(std::clamp<std::size_t>(chunks, 1, threads));
+	}
+
+	// Calls body(thread, first, last) for consecutive chunks [first, last) of [0, n), each grain
+	// items long and starting at a multiple of grain. Chunks are handed out dynamically to up to
+	// threads threads, numbered from 0 to parallel_threads(n, threads, grain) - 1, and the calling
+	// thread is thread 0. Small ranges run on the calling thread alone, so a parallel algorithm
+	// costs no more than a sequential one on small inputs. The first exception thrown by body
+	// stops any more chunks being handed out, and is rethrown once every thread has finished.
+	template<typename Body>
+	auto parallel_for(std::size_t n, unsigned threads, std::size_t grain, Body const& body) -> void {
+		auto const used = parallel_threads(n, threads, grain);
+		if (used == 1) {
+			for (auto first = std::size_t{0}; first < n; first += grain) {
+				body(0U, first, std::min(first + grain, n));
+			}
+			return;
+		}
+		auto next = std::atomic<std::size_t>{0};
+		auto failed = std::atomic<bool>{false};
+		auto error = std::exception_ptr();
+		auto const work = [&](unsigned thread) noexcept {
+			try {
+				for (auto first = next.fetch_add(grain); first < n; first = next.fetch_add(grain)) {
+					body(thread, first, std::min(first + grain, n));
+				}
+			} catch (...) {
+				// only the thread that sets failed writes error, and the join orders it before
+				// the rethrow
+				if (!failed.exchange(true)) {
+					error = std::current_exception();
+				}
+				next.store(n);
+			}
+		};
+		{
+			auto pool = std::vector<std::jthread>();
+			pool.reserve(used - 1);
+			for (auto thread = 1U; thread < used; ++thread) {
+				pool.emplace_back(work, thread);
+			}
+			work(0U);
+		}
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+	// Runs round(thread) on threads threads at once, numbered from 0 with the calling thread as 0,
+	// then between() on one of them once every round has finished, and repeats while between()
+	// returns true. The threads are started once and wait at a barrier between rounds, so an
+	// algorithm with many short rounds doesn't pay to start threads for each. The first exception
+	// thrown by round ends the rounds once every thread has reached the barrier, without calling
+	// between() again, and is rethrown once every thread has finished; so is one from between().
+	template<typename Round, typename Between>
+	auto parallel_rounds(unsigned threads, Round const& round, Between const& between) -> void {
+		if (threads <= 1) {
+			do {
+				round(0U);
+			} while (between());
+			return;
+		}
+		// only written by the barrier's completion, which happens before any thread moves on
+		auto done = false;
+		auto failed = std::atomic<bool>{false};
+		auto error = std::exception_ptr();
+		auto const complete = [&]() noexcept {
+			if (failed.load()) {
+				done = true;
+				return;
+			}
+			try {
+				done = !between();
+			} catch (...) {
+				error = std::current_exception();
+				done = true;
+			}
+		};
+		auto sync = std::barrier(static_cast<std::ptrdiff_t>(threads), complete);
+		auto const work = [&](unsigned thread) noexcept {
+			do {
+				try {
+					round(thread);
+				} catch (...) {
+					// only the thread that sets failed writes error, and the barrier orders it
+					// before the completion and the rethrow
+					if (!failed.exchange(true)) {
+						error = std::current_exception();
+					}
+				}
+				sync.arrive_and_wait();
+			} while (!done);
+		};
+		{
+			auto pool = std::vector<std::jthread>();
+			pool.reserve(threads - 1);
+			for (auto thread = 1U; thread < threads; ++thread) {
+				pool.emplace_back(work, thread);
+			}
+			work(0U);
+		}
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+	// One level of a parallel graph traversal: calls body(item, next) for every item of frontier,
+	// where body appends whatever should be visited after it to next, and returns all of them.
+	// Each thread appends to its own vector, so body only needs to synchronise claiming an item.
+	template<typename T, typename Body>
+	auto parallel_expand(std::vector<T> const& frontier,
+	                     unsigned threads,
+	                     std::size_t grain,
+	                     Body const& body) -> std::vector<T> {
+		auto next = std::vector<std::vector<T>>(parallel_threads(frontier.size(), threads, grain));
+		parallel_for(frontier.size(), threads, grain, [&](unsigned thread, auto first, auto last) {
+			for (auto i = first; i < last; ++i) {
+				body(frontier[i], next[thread]);
+			}
+		});
+		auto merged = std::move(next[0]);
+		for (auto thread = std::size_t{1}; thread < next.size(); ++thread) {
+			merged.insert(merged.end(), next[thread].begin(), next[thread].end());
+		}
+		return merged;
+	}
+} // namespace gdwg::detail
+
+#endif // GDWG_DETAIL_PARALLEL_HPP
@@ -0,0 +1,83 @@
+#ifndef GDWG_DETAIL_TEXT_HPP
+#define GDWG_DETAIL_TEXT_HPP
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <ios>
+#include <locale>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace gdwg::detail {
+	// The types append_text can write: numbers other than bool and the character types, which
+	// streams print as characters, and strings.
+	template<typename T>
+	concept text_value =
+	   (std::integral<T> && !std::same_as<T, bool> && !std::same_as<T, char>
+	    && !std::same_as<T, signed char> && !std::same_as<T, unsigned char>
+	    && !std::same_as<T, wchar_t> && !std::same_as<T, char8_t> && !std::same_as<T, char16_t>
+	    && !std::same_as<T, char32_t>)
+	   || std::floating_point<T> || std::same_as<T, std::string>
+	   || std::same_as<T, std::string_view>;
+
+	// The largest stream precision append_text handles, which bounds the length of a number.
+	inline constexpr auto max_text_precision = std::streamsize{256};
+
+	// Whether os prints a text_value exactly as append_text does: default flags, no field
+	// width, the classic locale and a precision in range.
+	inline auto plain_text_stream(std::ostream const& os) -> bool {
+		return os.flags() == (std::ios::skipws | std::ios::dec) && os.width() == 0
+		       && os.precision() >= 0 && os.precision() <= max_text_precision
+		       && os.getloc() == std::locale::classic();
+	}
+
+	// Appends value to out as a plain_text_stream with the given precision would print it.
+	// Streams print floating point values as printf's %.*g does, which to_chars's general
+	// format is specified to match.
+	template<text_value T>
+	auto append_text(std::string& out, T const& value, std::streamsize precision) -> void {
+		if constexpr (std::same_as<T, std::string> || std::same_as<T, std::string_view>) {
+			out += value;
+		}
+		else {
+			auto buffer = std::array<char, max_text_precision + 64>();
+			auto result = std::to_chars_result();
+			if constexpr (std::floating_point<T>) {
+				result = std::to_chars(buffer.data(),
+				                       buffer.data() + buffer.size(),
+				                       value,
+				                       std::chars_format::general,
+				                       static_cast<int>(precision));
+			}
+			else {
+				result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+			}
+			out.append(buffer.data(), result.ptr);
+		}
+	}
+
+	// Reads text, all of it, into value, as written by operator<< on a stream with the classic
+	// locale and default flags. Returns false if it isn't exactly one value.
+	template<typename T>
+	auto parse_text(std::string_view text, T& value) -> bool {
+		if constexpr (std::same_as<T, std::string> || std::same_as<T, std::string_view>) {
+			value = T(text);
+			return true;
+		}
+		else if constexpr (text_value<T>) {
+			auto const [ptr, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+			return error == std::errc() && ptr == text.data() + text.size();
+		}
+		else {
+			auto in = std::istringstream(std::string(text));
+			in.imbue(std::locale::classic());
+			in >> std::noskipws >> value;
+			return !in.fail() && in.peek() == std::istringstream::traits_type::eof();
+		}
+	}
+} // namespace gdwg::detail
+
+#endif // GDWG_DETAIL_TEXT_HPP
@@ -0,0 +1,311 @@
+#ifndef GDWG_EDGE_LIST_HPP
+#define GDWG_EDGE_LIST_HPP
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// The weight types an edge list can hold: anything std::from_chars parses.
+	template<typename T>
+	concept edge_list_value = (std::integral<T> && !std::same_as<T, bool>) || std::floating_point<T>;
+
+	// The node types an edge list can hold: numbers, or std::string for named nodes such as
+	// URLs. A name runs to the next space, tab or delimiter, so it can't contain one.
+	template<typename T>
+	concept edge_list_node = edge_list_value<T> || std::same_as<T, std::string>;
+
+	// Edge lists are text with one edge per line, as "src dst" or "src dst weight". Fields are
+	// separated by the delimiter, and spaces and tabs around fields are ignored, so SNAP files
+	// (tab or space separated, '#' comments), TSV and CSV all read with the defaults or a
+	// different delimiter. A tab delimiter still separates fields, so two in a row leave an empty
+	// field and the line is malformed. Blank lines, lines starting with the comment character,
+	// and a trailing '\r' are skipped.
+	template<edge_list_value E>
+	struct edge_list_options {
+		char delimiter = '\t';
+		char comment = '#';
+		// lines to skip at the start, such as a CSV header
+		std::size_t header_lines = 0;
+		// the weight of an edge whose line has no weight
+		E default_weight = E{1};
+		// How much of the input to read and parse at once. Each batch is split between threads
+		// at line boundaries, and its edges are handed over before the next is read, so memory
+		// stays proportional to this whatever the size of the input.
+		std::size_t batch_bytes = std::size_t{64} << 20;
+		// 0 uses every hardware thread
+		unsigned threads = 0;
+	};
+
+	// What reading an edge list got through, and how fast.
+	struct edge_list_stats {
+		std::size_t bytes = 0;
+		std::size_t lines = 0;
+		std::size_t edges = 0;
+		// wall time, including whatever the consumer of the edges took
+		double seconds = 0;
+
+		[[nodiscard]] auto megabytes_per_second() const noexcept -> double {
+			return seconds > 0 ? static_cast<double>(bytes) / 1e6 / seconds : 0.0;
+		}
+		[[nodiscard]] auto edges_per_second() const noexcept -> double {
+			return seconds > 0 ? static_cast<double>(edges) / seconds : 0.0;
+		}
+	};
+
+	namespace detail {
+		// The edges parsed from one run of whole lines.
+		template<typename N, typename E>
+		struct edge_list_piece {
+			std::vector<std::tuple<N, N, E>> edges;
+			std::size_t lines = 0;
+			// the line within the piece, from 0, of the first line that didn't parse
+			std::optional<std::size_t> malformed;
+		};
+
+		inline auto skip_blanks(char const* first, char const* last) noexcept -> char const* {
+			while (first != last && (*first == ' ' || *first == '\t')) {
+				++first;
+			}
+			return first;
+		}
+
+		// Skips the spaces and tabs around a field, but not the delimiter, which may be a tab.
+		inline auto skip_padding(char const* first, char const* last, char delimiter) noexcept
+		   -> char const* {
+			while (first != last && (*first == ' ' || *first == '\t') && *first != delimiter) {
+				++first;
+			}
+			return first;
+		}
+
+		// Parses a run of whole lines. Never throws on bad input, as it runs on worker threads;
+		// it records the first bad line instead and stops there.
+		template<typename N, typename E>
+		auto parse_edge_lines(std::string_view text,
+		                      edge_list_options<E> const& options,
+		                      edge_list_piece<N, E>& piece) -> void {
+			auto const* position = text.data();
+			auto const* const end = text.data() + text.size();
+			// parses a field into value, then skips the separator after it
+			auto const field = [&options](char const*& first, char const* last, auto& value) {
+				auto const* ptr = first;
+				if constexpr (std::same_as<std::remove_cvref_t<decltype(value)>, std::string>) {
+					while (ptr != last && *ptr != ' ' && *ptr != '\t' && *ptr != options.delimiter) {
+						++ptr;
+					}
+					if (ptr == first) {
+						return false;
+					}
+					value.assign(first, ptr);
+				}
+				else {
+					auto const result = std::from_chars(first, last, value);
+					if (result.ec != std::errc()) {
+						return false;
+					}
+					ptr = result.ptr;
+				}
+				first = skip_padding(ptr, last, options.delimiter);
+				if (first != last && *first == options.delimiter) {
+					first = skip_padding(first + 1, last, options.delimiter);
+				}
+				return true;
+			};
+			for (; position != end; ++piece.lines) {
+				auto const* line_end = static_cast<char const*>(
+				   std::memchr(position, '\n', static_cast<std::size_t>(end - position)));
+				auto const* const next = line_end == nullptr ? end : line_end + 1;
+				line_end = line_end == nullptr ? end : line_end;
+				if (line_end != position && *(line_end - 1) == '\r') {
+					--line_end;
+				}
+				auto const* const content = skip_blanks(position, line_end);
+				auto const* first = skip_padding(position, line_end, options.delimiter);
+				position = next;
+				if (content == line_end || *content == options.comment) {
+					continue;
+				}
+				auto src = N();
+				auto dst = N();
+				auto weight = options.default_weight;
+				if (!field(first, line_end, src) || !field(first, line_end, dst)
+				    || (first != line_end && !field(first, line_end, weight)) || first != line_end)
+				{
+					piece.malformed = piece.lines;
+					return;
+				}
+				piece.edges.emplace_back(std::move(src), std::move(dst), weight);
+			}
+		}
+
+		// Splits text, which ends with a whole line, into up to threads pieces at line
+		// boundaries and parses them in parallel.
+		template<typename N, typename E>
+		auto parse_edge_batch(std::string_view text,
+		                      edge_list_options<E> const& options,
+		                      unsigned threads) -> std::vector<edge_list_piece<N, E>> {
+			constexpr auto min_piece = std::size_t{1} << 20;
+			auto const count = parallel_threads(text.size(), threads, min_piece);
+			auto bounds = std::vector<std::size_t>{0};
+			for (auto i = std::size_t{1}; i < count; ++i) {
+				auto const newline = text.find('\n', std::max(bounds.back(), i * text.size() / count));
+				if (newline == std::string_view::npos) {
+					break;
+				}
+				bounds.push_back(newline + 1);
+			}
+			bounds.push_back(text.size());
+			auto pieces = std::vector<edge_list_piece<N, E>>(bounds.size() - 1);
+			parallel_for(pieces.size(), threads, 1, [&](unsigned, std::size_t first, std::size_t) {
+				auto const piece = text.substr(bounds[first], bounds[first + 1] - bounds[first]);
+				parse_edge_lines<N, E>(piece, options, pieces[first]);
+			});
+			return pieces;
+		}
+	} // namespace detail
+
+	// Reads an edge list from in, calling sink(std::span<std::tuple<N, N, E> const>) with the
+	// edges of each batch in input order. The input is read in large blocks and parsed across
+	// threads, numbers with std::from_chars, while sink runs on the calling thread between
+	// batches.
+	// Throws, naming the line, on the first line that isn't a well-formed edge; batches before
+	// it have already gone to sink.
+	template<edge_list_node N, edge_list_value E, typename Sink>
+	auto read_edge_list(std::istream& in, Sink&& sink, edge_list_options<E> const& options = {})
+	   -> edge_list_stats {
+		auto const start = std::chrono::steady_clock::now();
+		auto const threads = options.threads == 0 ? detail::default_threads() : options.threads;
+		auto stats = edge_list_stats();
+		// left uninitialised, so the pages of a large buffer a small input never reaches are
+		// never touched
+		auto capacity = std::max<std::size_t>(options.batch_bytes, 1);
+		auto buffer = std::make_unique_for_overwrite<char[]>(capacity);
+		// bytes at the front of buffer carried over from the last read, which end mid-line
+		auto carried = std::size_t{0};
+		auto header_lines = options.header_lines;
+		auto batch = std::vector<std::tuple<N, N, E>>();
+		for (auto done = false; !done;) {
+			if (carried == capacity) {
+				// a single line longer than the buffer
+				auto grown = std::make_unique_for_overwrite<char[]>(capacity * 2);
+				std::memcpy(grown.get(), buffer.get(), carried);
+				buffer = std::move(grown);
+				capacity *= 2;
+			}
+			in.read(buffer.get() + carried, static_cast<std::streamsize>(capacity - carried));
+			auto const read = static_cast<std::size_t>(in.gcount());
+			stats.bytes += read;
+			done = read == 0 || in.eof();
+			auto text = std::string_view(buffer.get(), carried + read);
+			// parse up to the last newline, or everything once the input has run out
+			auto const last_newline = text.rfind('\n');
+			auto const whole = done ? text.size()
+			                        : (last_newline == std::string_view::npos ? 0 : last_newline + 1);
+			auto lines = text.substr(0, whole);
+			for (; header_lines > 0 && !lines.empty(); --header_lines, ++stats.lines) {
+				auto const newline = lines.find('\n');
+				lines.remove_prefix(newline == std::string_view::npos ? lines.size() : newline + 1);
+			}
+
+			auto pieces = detail::parse_edge_batch<N, E>(lines, options, threads);
+			batch.clear();
+			if (pieces.size() == 1) {
+				std::swap(batch, pieces.front().edges);
+			}
+			else {
+				auto size = std::size_t{0};
+				for (auto const& piece : pieces) {
+					size += piece.edges.size();
+				}
+				batch.reserve(size);
+			}
+			for (auto& piece : pieces) {
+				if (piece.malformed) {
+					throw std::runtime_error("Cannot call gdwg::read_edge_list on input with a "
+					                         "malformed edge on line "
+					                         + std::to_string(stats.lines + *piece.malformed + 1));
+				}
+				stats.lines += piece.lines;
+				if (pieces.size() > 1) {
+					batch.insert(batch.end(),
+					             std::make_move_iterator(piece.edges.begin()),
+					             std::make_move_iterator(piece.edges.end()));
+				}
+			}
+			if (!batch.empty()) {
+				stats.edges += batch.size();
+				sink(std::span<std::tuple<N, N, E> const>(batch));
+			}
+			carried = text.size() - whole;
+			std::memmove(buffer.get(), buffer.get() + whole, carried);
+		}
+		if (in.bad()) {
+			throw std::runtime_error("Cannot call gdwg::read_edge_list on a stream that can't be "
+			                         "read");
+		}
+		stats.seconds =
+		   std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return stats;
+	}
+
+	template<edge_list_node N, edge_list_value E, typename Sink>
+	auto read_edge_list(std::filesystem::path const& path,
+	                    Sink&& sink,
+	                    edge_list_options<E> const& options = {}) -> edge_list_stats {
+		auto in = std::ifstream(path, std::ios::binary);
+		if (!in) {
+			throw std::runtime_error("Cannot call gdwg::read_edge_list on a file that can't be "
+			                         "opened");
+		}
+		return read_edge_list<N, E>(in, std::forward<Sink>(sink), options);
+	}
+
+	// Reads an edge list from in into g, inserting every node it names. Each batch goes through
+	// graph::insert_edges, which sorts it and merges it into the edge sets in one pass.
+	template<edge_list_node N, edge_list_value E, typename Storage>
+	auto load_edge_list(graph<N, E, Storage>& g,
+	                    std::istream& in,
+	                    edge_list_options<E> const& options = {}) -> edge_list_stats {
+		return read_edge_list<N, E>(
+		   in,
+		   [&g](std::span<std::tuple<N, N, E> const> edges) {
+			   g.insert_edges(edges.begin(), edges.end(), true);
+		   },
+		   options);
+	}
+
+	template<edge_list_node N, edge_list_value E, typename Storage>
+	auto load_edge_list(graph<N, E, Storage>& g,
+	                    std::filesystem::path const& path,
+	                    edge_list_options<E> const& options = {}) -> edge_list_stats {
+		auto in = std::ifstream(path, std::ios::binary);
+		if (!in) {
+			throw std::runtime_error("Cannot call gdwg::load_edge_list on a file that can't be "
+			                         "opened");
+		}
+		return load_edge_list(g, in, options);
+	}
+} // namespace gdwg
+
+#endif // GDWG_EDGE_LIST_HPP
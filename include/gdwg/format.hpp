@@ -0,0 +1,99 @@
+#ifndef GDWG_FORMAT_HPP
+#define GDWG_FORMAT_HPP
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <ios>
+#include <locale>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <version>
+
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+#if defined(GDWG_WITH_FMT)
+#include <fmt/format.h>
+#endif
+
+// Formatters for graph, for std::format where the standard library has it and for fmt when
+// GDWG_WITH_FMT is defined, which needs fmt on the include path and linked. The text is exactly
+// what operator<< writes, and an empty format spec is the only one accepted.
+
+namespace gdwg::detail {
+	// A stream buffer that writes straight to a format context's output iterator.
+	template<typename Out>
+	class iterator_streambuf : public std::streambuf {
+	public:
+		explicit iterator_streambuf(Out out)
+		: out_(std::move(out)) {}
+
+		[[nodiscard]] auto out() const -> Out {
+			return out_;
+		}
+
+	protected:
+		auto overflow(int_type c) -> int_type override {
+			if (!traits_type::eq_int_type(c, traits_type::eof())) {
+				*out_++ = traits_type::to_char_type(c);
+			}
+			return traits_type::not_eof(c);
+		}
+
+		auto xsputn(char const* s, std::streamsize n) -> std::streamsize override {
+			out_ = std::copy_n(s, n, out_);
+			return n;
+		}
+
+	private:
+		Out out_;
+	};
+
+	template<typename N, typename E, typename Storage, typename Out>
+	auto format_graph(graph<N, E, Storage> const& g, Out out) -> Out {
+		auto buffer = iterator_streambuf<Out>(std::move(out));
+		auto os = std::ostream(&buffer);
+		// a new stream takes the global locale, which the formatters must ignore
+		os.imbue(std::locale::classic());
+		os << g;
+		return buffer.out();
+	}
+} // namespace gdwg::detail
+
+#if defined(__cpp_lib_format)
+template<typename N, typename E, typename Storage>
+struct std::formatter<gdwg::graph<N, E, Storage>> {
+	constexpr auto parse(std::format_parse_context& ctx) -> std::format_parse_context::iterator {
+		if (ctx.begin() != ctx.end() && *ctx.begin() != '}') {
+			throw std::format_error("Cannot format gdwg::graph<N, E> with a format spec");
+		}
+		return ctx.begin();
+	}
+
+	template<typename FormatContext>
+	auto format(gdwg::graph<N, E, Storage> const& g, FormatContext& ctx) const {
+		return gdwg::detail::format_graph(g, ctx.out());
+	}
+};
+#endif
+
+#if defined(GDWG_WITH_FMT)
+template<typename N, typename E, typename Storage>
+struct fmt::formatter<gdwg::graph<N, E, Storage>> {
+	constexpr auto parse(fmt::format_parse_context& ctx) -> fmt::format_parse_context::iterator {
+		if (ctx.begin() != ctx.end() && *ctx.begin() != '}') {
+			throw fmt::format_error("Cannot format gdwg::graph<N, E> with a format spec");
+		}
+		return ctx.begin();
+	}
+
+	template<typename FormatContext>
+	auto format(gdwg::graph<N, E, Storage> const& g, FormatContext& ctx) const {
+		return gdwg::detail::format_graph(g, ctx.out());
+	}
+};
+#endif
+
+#endif // GDWG_FORMAT_HPP
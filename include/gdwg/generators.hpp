@@ -0,0 +1,349 @@
+#ifndef GDWG_GENERATORS_HPP
+#define GDWG_GENERATORS_HPP
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace gdwg {
+	// Deterministic synthetic graphs for benchmarks and tests.
+	// A generator describes a random graph over the nodes [0, node_count()). Edge i is computed
+	// from the seed and i alone, so the edges stream out in O(1) memory, any slice of the stream
+	// can be generated on its own (and so in parallel), and a seed always gives the same graph.
+	// Every generator is a range of generated_edge and provides edge(i) and edge_count().
+
+	struct generated_edge {
+		std::uint64_t src;
+		std::uint64_t dst;
+		std::uint32_t weight;
+
+		[[nodiscard]] auto operator==(generated_edge const&) const -> bool = default;
+	};
+
+	namespace detail {
+		// The SplitMix64 finaliser, which turns a counter into well mixed bits.
+		constexpr auto mix(std::uint64_t x) noexcept -> std::uint64_t {
+			x += 0x9e3779b97f4a7c15;
+			x = (x ^ (x >> 30U)) * 0xbf58476d1ce4e5b9;
+			x = (x ^ (x >> 27U)) * 0x94d049bb133111eb;
+			return x ^ (x >> 31U);
+		}
+
+		// Independent random bits for each (seed, index, stream), where stream (below 32)
+		// separates the different draws made for one edge.
+		constexpr auto
+		random_bits(std::uint64_t seed, std::uint64_t index, std::uint64_t stream) noexcept
+		   -> std::uint64_t {
+			return mix(seed ^ mix(index * 32 + stream));
+		}
+
+		// A value in [0, n) from random bits. The modulo bias is at most n / 2^64.
+		constexpr auto bounded(std::uint64_t bits, std::uint64_t n) noexcept -> std::uint64_t {
+			return bits % n;
+		}
+
+		// Throws unless max_weight leaves a weight to choose, on behalf of the generator named.
+		inline auto check_max_weight(std::uint32_t max_weight, char const* generator) -> void {
+			if (max_weight == 0) {
+				throw std::invalid_argument(std::string("Cannot construct gdwg::") + generator
+				                            + " with a max_weight of 0");
+			}
+		}
+
+		// The weight of edge i, in [1, max_weight]. Stream 0 is kept for weights.
+		constexpr auto
+		random_weight(std::uint64_t seed, std::uint64_t i, std::uint32_t max_weight) noexcept
+		   -> std::uint32_t {
+			return 1 + static_cast<std::uint32_t>(bounded(random_bits(seed, i, 0), max_weight));
+		}
+
+		// Provides the range interface of a generator from its edge(i) and edge_count().
+		template<typename Generator>
+		class edge_range {
+		public:
+			class iterator {
+			public:
+				using value_type = generated_edge;
+				using reference = generated_edge;
+				using pointer = void;
+				using difference_type = std::ptrdiff_t;
+				// edges are computed rather than stored, so the iterator can't hand out a reference
+				// as a legacy forward iterator must, but a range can be walked more than once
+				using iterator_category = std::input_iterator_tag;
+				using iterator_concept = std::forward_iterator_tag;
+
+				iterator() = default;
+				iterator(Generator const* generator, std::uint64_t index)
+				: generator_(generator)
+				, index_(index) {}
+
+				auto operator*() const -> reference {
+					return generator_->edge(index_);
+				}
+				auto operator++() -> iterator& {
+					++index_;
+					return *this;
+				}
+				auto operator++(int) -> iterator {
+					auto ret = *this;
+					++*this;
+					return ret;
+				}
+				auto operator==(iterator const& other) const -> bool {
+					return index_ == other.index_;
+				}
+
+			private:
+				Generator const* generator_ = nullptr;
+				std::uint64_t index_ = 0;
+			};
+
+			[[nodiscard]] auto begin() const noexcept -> iterator {
+				return iterator(static_cast<Generator const*>(this), 0);
+			}
+			[[nodiscard]] auto end() const noexcept -> iterator {
+				return iterator(static_cast<Generator const*>(this),
+				                static_cast<Generator const*>(this)->edge_count());
+			}
+		};
+	} // namespace detail
+
+	// R-MAT (recursive matrix) graphs, as used by Graph500. Each edge descends `scale` levels of
+	// the adjacency matrix, picking a quadrant with probabilities a, b, c and 1 - a - b - c, which
+	// gives a power-law degree distribution with the hubs at the low ids.
+	class rmat_generator : public detail::edge_range<rmat_generator> {
+	public:
+		rmat_generator(unsigned scale,
+		               std::uint64_t edges,
+		               std::uint64_t seed,
+		               double a = 0.57,
+		               double b = 0.19,
+		               double c = 0.19,
+		               std::uint32_t max_weight = 1000)
+		: scale_(scale)
+		, edges_(edges)
+		, seed_(seed)
+		, max_weight_(max_weight) {
+			detail::check_max_weight(max_weight, "rmat_generator");
+			if (scale >= 64 || a < 0 || b < 0 || c < 0 || a + b + c > 1) {
+				throw std::invalid_argument("Cannot construct gdwg::rmat_generator with a scale of 64 "
+				                            "or more or with invalid quadrant probabilities");
+			}
+			// the quadrant is chosen from 16 random bits per level
+			a_ = static_cast<std::uint32_t>(a * 65536);
+			ab_ = static_cast<std::uint32_t>((a + b) * 65536);
+			abc_ = static_cast<std::uint32_t>((a + b + c) * 65536);
+		}
+
+		[[nodiscard]] auto node_count() const noexcept -> std::uint64_t {
+			return std::uint64_t{1} << scale_;
+		}
+		[[nodiscard]] auto edge_count() const noexcept -> std::uint64_t {
+			return edges_;
+		}
+		[[nodiscard]] auto edge(std::uint64_t i) const noexcept -> generated_edge {
+			auto src = std::uint64_t{0};
+			auto dst = std::uint64_t{0};
+			auto bits = std::uint64_t{0};
+			for (auto level = 0U; level < scale_; ++level) {
+				// each 64 random bits cover four levels
+				if (level % 4 == 0) {
+					bits = detail::random_bits(seed_, i, 1 + level / 4);
+				}
+				auto const r = static_cast<std::uint32_t>(bits & 0xffffU);
+				bits >>= 16U;
+				// the quadrants in order are (0, 0), (0, 1), (1, 0), (1, 1); computing the bits
+				// without branches avoids a misprediction on most levels
+				auto const past_a = static_cast<std::uint64_t>(r >= a_);
+				auto const past_ab = static_cast<std::uint64_t>(r >= ab_);
+				auto const past_abc = static_cast<std::uint64_t>(r >= abc_);
+				src = (src << 1U) | past_ab;
+				dst = (dst << 1U) | (past_a ^ past_ab ^ past_abc);
+			}
+			return {src, dst, detail::random_weight(seed_, i, max_weight_)};
+		}
+
+	private:
+		unsigned scale_;
+		std::uint64_t edges_;
+		std::uint64_t seed_;
+		std::uint32_t max_weight_;
+		std::uint32_t a_;
+		std::uint32_t ab_;
+		std::uint32_t abc_;
+	};
+
+	// Erdős–Rényi G(n, m) graphs: m edges whose endpoints are chosen uniformly at random, so
+	// degrees are binomially distributed around m / n. Repeated edges are possible.
+	class erdos_renyi_generator : public detail::edge_range<erdos_renyi_generator> {
+	public:
+		erdos_renyi_generator(std::uint64_t nodes,
+		                      std::uint64_t edges,
+		                      std::uint64_t seed,
+		                      std::uint32_t max_weight = 1000)
+		: nodes_(nodes)
+		, edges_(edges)
+		, seed_(seed)
+		, max_weight_(max_weight) {
+			detail::check_max_weight(max_weight, "erdos_renyi_generator");
+			if (nodes == 0 && edges != 0) {
+				throw std::invalid_argument("Cannot construct gdwg::erdos_renyi_generator with edges "
+				                            "but no nodes");
+			}
+		}
+
+		[[nodiscard]] auto node_count() const noexcept -> std::uint64_t {
+			return nodes_;
+		}
+		[[nodiscard]] auto edge_count() const noexcept -> std::uint64_t {
+			return edges_;
+		}
+		[[nodiscard]] auto edge(std::uint64_t i) const noexcept -> generated_edge {
+			return {detail::bounded(detail::random_bits(seed_, i, 1), nodes_),
+			        detail::bounded(detail::random_bits(seed_, i, 2), nodes_),
+			        detail::random_weight(seed_, i, max_weight_)};
+		}
+
+	private:
+		std::uint64_t nodes_;
+		std::uint64_t edges_;
+		std::uint64_t seed_;
+		std::uint32_t max_weight_;
+	};
+
+	// Barabási–Albert preferential attachment: node v arrives with edges_per_node edges to nodes
+	// already in the graph (itself included), each picked with probability proportional to its
+	// degree. Follows Batagelj and Brandes: the endpoint list M has M[2k] = the source of edge k,
+	// and M[2k + 1] = M[r] for a uniform r <= 2k. M is never stored; an odd position is resolved
+	// by following r until it lands on an even one, which takes two steps on average.
+	class barabasi_albert_generator : public detail::edge_range<barabasi_albert_generator> {
+	public:
+		barabasi_albert_generator(std::uint64_t nodes,
+		                          std::uint64_t edges_per_node,
+		                          std::uint64_t seed,
+		                          std::uint32_t max_weight = 1000)
+		: nodes_(nodes)
+		, per_node_(edges_per_node)
+		, seed_(seed)
+		, max_weight_(max_weight) {
+			detail::check_max_weight(max_weight, "barabasi_albert_generator");
+			if (edges_per_node == 0) {
+				throw std::invalid_argument("Cannot construct gdwg::barabasi_albert_generator with no "
+				                            "edges per node");
+			}
+		}
+
+		[[nodiscard]] auto node_count() const noexcept -> std::uint64_t {
+			return nodes_;
+		}
+		[[nodiscard]] auto edge_count() const noexcept -> std::uint64_t {
+			return nodes_ * per_node_;
+		}
+		[[nodiscard]] auto edge(std::uint64_t i) const noexcept -> generated_edge {
+			return {i / per_node_, endpoint(2 * i + 1), detail::random_weight(seed_, i, max_weight_)};
+		}
+
+	private:
+		// The node at position m of the endpoint list.
+		auto endpoint(std::uint64_t m) const noexcept -> std::uint64_t {
+			while (m % 2 == 1) {
+				m = detail::bounded(detail::random_bits(seed_, m, 1), m);
+			}
+			return m / 2 / per_node_;
+		}
+
+		std::uint64_t nodes_;
+		std::uint64_t per_node_;
+		std::uint64_t seed_;
+		std::uint32_t max_weight_;
+	};
+
+	// A rows x columns grid where each cell has an edge to and from each of its four neighbours,
+	// like a road network: low uniform degree and a large diameter. Node (r, c) is r * columns + c.
+	class grid_generator : public detail::edge_range<grid_generator> {
+	public:
+		grid_generator(std::uint64_t rows,
+		               std::uint64_t columns,
+		               std::uint64_t seed,
+		               std::uint32_t max_weight = 1000)
+		: rows_(rows)
+		, columns_(columns)
+		, seed_(seed)
+		, max_weight_(max_weight) {
+			detail::check_max_weight(max_weight, "grid_generator");
+		}
+
+		[[nodiscard]] auto node_count() const noexcept -> std::uint64_t {
+			return rows_ * columns_;
+		}
+		[[nodiscard]] auto edge_count() const noexcept -> std::uint64_t {
+			return 2 * (horizontal() + vertical());
+		}
+		// The edges come in pairs, i and i + 1 joining the same two cells in opposite directions
+		// with independently drawn weights.
+		[[nodiscard]] auto edge(std::uint64_t i) const noexcept -> generated_edge {
+			auto const pair = i / 2;
+			auto src = std::uint64_t{0};
+			auto dst = std::uint64_t{0};
+			if (pair < horizontal()) {
+				auto const row = pair / (columns_ - 1);
+				src = row * columns_ + pair % (columns_ - 1);
+				dst = src + 1;
+			}
+			else {
+				src = pair - horizontal();
+				dst = src + columns_;
+			}
+			if (i % 2 == 1) {
+				std::swap(src, dst);
+			}
+			return {src, dst, detail::random_weight(seed_, i, max_weight_)};
+		}
+
+	private:
+		auto horizontal() const noexcept -> std::uint64_t {
+			return columns_ == 0 ? 0 : rows_ * (columns_ - 1);
+		}
+		auto vertical() const noexcept -> std::uint64_t {
+			return rows_ == 0 ? 0 : (rows_ - 1) * columns_;
+		}
+
+		std::uint64_t rows_;
+		std::uint64_t columns_;
+		std::uint64_t seed_;
+		std::uint32_t max_weight_;
+	};
+
+	// Inserts the nodes N(0) ... N(node_count - 1) and every generated edge into g, with the
+	// weight converted to E. The edges go through insert_edges in chunks of chunk_size, so memory
+	// use stays bounded by the graph rather than the length of the stream. Returns the number of
+	// edges that were new to g.
+	template<typename N, typename E, typename Storage, typename Generator>
+	auto insert_generated(graph<N, E, Storage>& g,
+	                      Generator const& generator,
+	                      std::size_t chunk_size = std::size_t{1} << 20U) -> std::size_t {
+		for (auto node = std::uint64_t{0}; node < generator.node_count(); ++node) {
+			g.insert_node(static_cast<N>(node));
+		}
+		auto inserted = std::size_t{0};
+		auto chunk = std::vector<std::tuple<N, N, E>>();
+		chunk.reserve(
+		   static_cast<std::size_t>(std::min<std::uint64_t>(chunk_size, generator.edge_count())));
+		for (auto const& [src, dst, weight] : generator) {
+			chunk.emplace_back(static_cast<N>(src), static_cast<N>(dst), static_cast<E>(weight));
+			if (chunk.size() == chunk_size) {
+				inserted += g.insert_edges(chunk.begin(), chunk.end());
+				chunk.clear();
+			}
+		}
+		return inserted + g.insert_edges(chunk.begin(), chunk.end());
+	}
+} // namespace gdwg
+
+#endif // GDWG_GENERATORS_HPP
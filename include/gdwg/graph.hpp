@@ -1,56 +1,148 @@
 #ifndef GDWG_GRAPH_HPP
 #define GDWG_GRAPH_HPP
+#include "gdwg/detail/text.hpp"
+#include "gdwg/storage.hpp"
+
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <iterator>
-#include <map>
 #include <memory>
-#include <set>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace gdwg {
-	template<typename N, typename E>
+	template<typename N, typename E, typename Storage = ordered_storage>
 	class graph {
+		// Every node is interned to a 32-bit id when it is inserted, and edges refer to their
+		// destination by id so each N is stored exactly once. Ids are translated back to N only
+		// at the API boundary.
+		using node_id = std::uint32_t;
+		struct node_ids;
+
+		// Orders edges by the destination's value then weight, so iteration order is the same as
+		// if the destination were stored by value. Equal ids short-circuit to an integer compare.
+		// It is transparent so the edges to a given destination can be found with
+		// equal_range(dst_id) without knowing their weights.
+		struct edge_compare {
+			using is_transparent = void;
+
+			auto operator()(std::pair<node_id, E> const& lhs, std::pair<node_id, E> const& rhs) const
+			   -> bool {
+				if (lhs.first == rhs.first) {
+					return lhs.second < rhs.second;
+				}
+				return ids->name(lhs.first) < ids->name(rhs.first);
+			}
+			auto operator()(std::pair<node_id, E> const& lhs, node_id rhs) const -> bool {
+				return lhs.first != rhs && ids->name(lhs.first) < ids->name(rhs);
+			}
+			auto operator()(node_id lhs, std::pair<node_id, E> const& rhs) const -> bool {
+				return lhs != rhs.first && ids->name(lhs) < ids->name(rhs.first);
+			}
+
+			node_ids const* ids = nullptr;
+		};
+		using adjacency_set = typename Storage::template set<std::pair<node_id, E>, edge_compare>;
+
+		struct node_edges {
+			// outgoing edges
+			adjacency_set out;
+			// reverse index: every node with at least one edge into this node
+			typename Storage::template set<node_id, std::less<>> in;
+			node_id id;
+		};
+		using node_map = typename Storage::template node_map<N, node_edges>;
+		using node_entry = typename node_map::value_type;
+
+		// id -> node table. Ids of erased nodes are recycled by later insertions.
+		struct node_ids {
+			[[nodiscard]] auto name(node_id id) const noexcept -> N const& {
+				return entries[id]->first;
+			}
+
+			std::vector<node_entry*> entries;
+			std::vector<node_id> free;
+			// With an ordered node table, the first node that has an outgoing edge, so begin()
+			// doesn't have to search for it. Empty when there are no edges.
+			std::optional<typename node_map::const_iterator> first_source;
+		};
+
 		struct value_type {
 			N from;
 			N to;
 			E weight;
 		};
+		// What an iterator dereferences to. It refers into the graph, so visiting an edge copies
+		// neither node nor the weight, and converts to value_type when a copy is wanted.
+		struct edge_reference {
+			N const& from;
+			N const& to;
+			E const& weight;
+
+			operator value_type() const {
+				return value_type{from, to, weight};
+			}
+		};
+		// The result of iterator::operator->, which holds the edge_reference it points to.
+		struct edge_pointer {
+			edge_reference ref;
+
+			auto operator->() const noexcept -> edge_reference const* {
+				return &ref;
+			}
+		};
 		class iterator {
-			using outer_iterator = typename std::map<N, std::set<std::pair<N, E>>>::const_iterator;
-			using inner_iterator = typename std::set<std::pair<N, E>>::const_iterator;
+			using outer_iterator = typename node_map::const_iterator;
+			using inner_iterator = typename adjacency_set::const_iterator;
 
 		public:
-			using value_type = graph<N, E>::value_type;
-			using reference = value_type;
-			using pointer = void;
+			using value_type = typename graph::value_type;
+			using reference = edge_reference;
+			using pointer = edge_pointer;
 			using difference_type = std::ptrdiff_t;
-			using iterator_category = std::bidirectional_iterator_tag;
+			// an unordered node table can only be walked forwards
+			using iterator_category = std::conditional_t<Storage::ordered,
+			                                             std::bidirectional_iterator_tag,
+			                                             std::forward_iterator_tag>;
 
 			// Iterator constructor
 			explicit iterator() = default;
 
-			explicit iterator(outer_iterator outer, inner_iterator inner, outer_iterator end)
+			explicit iterator(outer_iterator outer,
+			                  inner_iterator inner,
+			                  outer_iterator end,
+			                  node_ids const* ids)
 			: outer_(outer)
 			, inner_(inner)
-			, outer_end_(end) {}
+			, outer_end_(end)
+			, ids_(ids) {}
 
 			// Iterator source
-			auto operator*() const -> const reference {
-				return reference{outer_->first, inner_->first, inner_->second};
+			auto operator*() const noexcept -> reference {
+				return reference{outer_->first, ids_->name(inner_->first), inner_->second};
 			}
 
-			auto operator->() const -> pointer {
-				return &(this->operator*());
+			auto operator->() const noexcept -> pointer {
+				return pointer{**this};
 			}
 
 			// Iterator traversal
 			// Precondition starting node has an edge
 			auto operator++() -> iterator& {
 				// increment inner_ if not at end and return value
-				if (inner_ != outer_->second.cend()) {
+				if (inner_ != outer_->second.out.cend()) {
 					++inner_;
-					if (inner_ != outer_->second.cend()) {
+					if (inner_ != outer_->second.out.cend()) {
 						return *this;
 					}
 				}
@@ -62,7 +154,7 @@ namespace gdwg {
 				}
 				else {
 					// skips nodes with no edges
-					while (outer_->second.empty()) {
+					while (outer_->second.out.empty()) {
 						++outer_;
 						// reached the end of structure
 						if (outer_ == outer_end_) {
@@ -70,7 +162,7 @@ namespace gdwg {
 							return *this;
 						}
 					}
-					inner_ = outer_->second.cbegin();
+					inner_ = outer_->second.out.cbegin();
 				}
 				return *this;
 			}
@@ -82,9 +174,9 @@ namespace gdwg {
 			}
 			auto operator--() -> iterator& {
 				// skips nodes with no edges
-				while (outer_ == outer_end_ || inner_ == outer_->second.cbegin()) {
+				while (outer_ == outer_end_ || inner_ == outer_->second.out.cbegin()) {
 					--outer_;
-					inner_ = outer_->second.cend();
+					inner_ = outer_->second.out.cend();
 				}
 				--inner_;
 				return *this;
@@ -102,97 +194,377 @@ namespace gdwg {
 			outer_iterator outer_;
 			inner_iterator inner_;
 			outer_iterator outer_end_;
+			node_ids const* ids_ = nullptr;
 
 			// To allow graph to modify this
-			friend class graph<N, E>;
+			friend class graph;
+		};
+		// The distinct destinations of one node's edges in ascending order, read in place from the
+		// node table. Edges to the same destination are adjacent in the edge set, so each step
+		// skips past the run for the current one. A std::ranges::view, so it composes with the
+		// std::views adaptors. Invalidated along with iterators to the node's edges.
+		class connection_view : public std::ranges::view_interface<connection_view> {
+			using edge_iterator = typename adjacency_set::const_iterator;
+
+		public:
+			class iterator {
+			public:
+				using value_type = N;
+				using reference = N const&;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::forward_iterator_tag;
+
+				iterator() = default;
+
+				auto operator*() const noexcept -> reference {
+					return ids_->name(edge_->first);
+				}
+
+				auto operator++() -> iterator& {
+					auto const dst = edge_->first;
+					do {
+						++edge_;
+					} while (edge_ != last_ && edge_->first == dst);
+					return *this;
+				}
+
+				auto operator++(int) -> iterator {
+					auto ret = *this;
+					++*this;
+					return ret;
+				}
+
+				auto operator==(iterator const& other) const noexcept -> bool {
+					return edge_ == other.edge_;
+				}
+
+			private:
+				iterator(edge_iterator edge, edge_iterator last, node_ids const* ids)
+				: edge_(edge)
+				, last_(last)
+				, ids_(ids) {}
+
+				edge_iterator edge_;
+				edge_iterator last_;
+				node_ids const* ids_ = nullptr;
+
+				friend class connection_view;
+			};
+
+			// An empty view over no node's edges.
+			connection_view() = default;
+
+			[[nodiscard]] auto begin() const noexcept -> iterator {
+				return iterator(first_, last_, ids_);
+			}
+			[[nodiscard]] auto end() const noexcept -> iterator {
+				return iterator(last_, last_, ids_);
+			}
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return first_ == last_;
+			}
+
+		private:
+			connection_view(edge_iterator first, edge_iterator last, node_ids const* ids)
+			: first_(first)
+			, last_(last)
+			, ids_(ids) {}
+
+			edge_iterator first_;
+			edge_iterator last_;
+			node_ids const* ids_ = nullptr;
+
+			friend class graph;
+		};
+
+		// Records modifications to be applied together by commit(). Each run of consecutive
+		// insert_edge and erase_edge calls is applied with one merge per touched edge set and one
+		// update per touched reverse index entry; node operations are applied as they are reached.
+		// Every recording function returns the position of its result in commit's return value.
+		class mutation_batch {
+			enum class op_kind {
+				insert_node,
+				erase_node,
+				replace_node,
+				merge_replace_node,
+				insert_edge,
+				erase_edge,
+			};
+
+		public:
+			explicit mutation_batch(graph& g) noexcept
+			: graph_(&g) {}
+
+			auto insert_node(N const& value) -> std::size_t {
+				return record_node(op_kind::insert_node, value, value);
+			}
+			auto erase_node(N const& value) -> std::size_t {
+				return record_node(op_kind::erase_node, value, value);
+			}
+			auto replace_node(N const& old_data, N const& new_data) -> std::size_t {
+				return record_node(op_kind::replace_node, old_data, new_data);
+			}
+			auto merge_replace_node(N const& old_data, N const& new_data) -> std::size_t {
+				return record_node(op_kind::merge_replace_node, old_data, new_data);
+			}
+			auto insert_edge(N const& src, N const& dst, E const& weight) -> std::size_t {
+				return record_edge(op_kind::insert_edge, src, dst, weight);
+			}
+			auto erase_edge(N const& src, N const& dst, E const& weight) -> std::size_t {
+				return record_edge(op_kind::erase_edge, src, dst, weight);
+			}
+
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return ops_.empty();
+			}
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return ops_.size();
+			}
+
+			// Applies the recorded operations in order and returns what each would have returned
+			// as a single call, with true for merge_replace_node. Errors are thrown as the single
+			// calls throw them. A run of edge operations is checked before any of it is applied,
+			// but operations before the failing run stay applied. The batch is empty afterwards.
+			auto commit() -> std::vector<bool> {
+				auto const ops = std::exchange(ops_, {});
+				auto const node_args = std::exchange(node_args_, {});
+				auto const edge_args = std::exchange(edge_args_, {});
+				auto results = std::vector<bool>(ops.size());
+				for (auto i = std::size_t{0}; i < ops.size();) {
+					auto const [kind, arg] = ops[i];
+					if (kind == op_kind::insert_edge || kind == op_kind::erase_edge) {
+						auto last = i;
+						while (last < ops.size()
+						       && (ops[last].first == op_kind::insert_edge
+						           || ops[last].first == op_kind::erase_edge))
+						{
+							++last;
+						}
+						apply_edges(ops, edge_args, i, last, results);
+						i = last;
+						continue;
+					}
+					auto const& [first, second] = node_args[arg];
+					switch (kind) {
+					case op_kind::insert_node: results[i] = graph_->insert_node(first); break;
+					case op_kind::erase_node: results[i] = graph_->erase_node(first); break;
+					case op_kind::replace_node: results[i] = graph_->replace_node(first, second); break;
+					default:
+						graph_->merge_replace_node(first, second);
+						results[i] = true;
+					}
+					++i;
+				}
+				return results;
+			}
+
+		private:
+			using op = std::pair<op_kind, std::size_t>;
+
+			auto record_node(op_kind kind, N const& first, N const& second) -> std::size_t {
+				node_args_.emplace_back(first, second);
+				ops_.emplace_back(kind, node_args_.size() - 1);
+				return ops_.size() - 1;
+			}
+			auto record_edge(op_kind kind, N const& src, N const& dst, E const& weight)
+			   -> std::size_t {
+				edge_args_.emplace_back(src, dst, weight);
+				ops_.emplace_back(kind, edge_args_.size() - 1);
+				return ops_.size() - 1;
+			}
+
+			// Applies the edge operations ops[first, last). The operations on one edge are replayed
+			// against whether it exists to find their results, and only the edges whose existence
+			// changes touch the edge sets.
+			auto apply_edges(std::vector<op> const& ops,
+			                 std::vector<std::tuple<N, N, E>> const& edge_args,
+			                 std::size_t first,
+			                 std::size_t last,
+			                 std::vector<bool>& results) -> void {
+				struct pending {
+					node_id src;
+					node_id dst;
+					E const* weight;
+					std::size_t op;
+				};
+				auto& nodes = *graph_->nodes_.get();
+				auto edges = std::vector<pending>();
+				edges.reserve(last - first);
+				for (auto i = first; i < last; ++i) {
+					auto const& [src, dst, weight] = edge_args[ops[i].second];
+					auto const src_it = nodes.find(src);
+					auto const dst_it = nodes.find(dst);
+					if (src_it == nodes.end() || dst_it == nodes.end()) {
+						if (ops[i].first == op_kind::insert_edge) {
+							throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edge when "
+							                         "either src or dst node does not exist");
+						}
+						throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edge on src or "
+						                         "dst if they don't exist in the graph");
+					}
+					edges.push_back(pending{src_it->second.id, dst_it->second.id, &weight, i});
+				}
+				// the sort is stable, so the operations on one edge stay in the order they were made
+				auto const key_less = [](pending const& lhs, pending const& rhs) {
+					if (lhs.src != rhs.src) {
+						return lhs.src < rhs.src;
+					}
+					if (lhs.dst != rhs.dst) {
+						return lhs.dst < rhs.dst;
+					}
+					return *lhs.weight < *rhs.weight;
+				};
+				std::stable_sort(edges.begin(), edges.end(), key_less);
+
+				auto added = std::vector<std::pair<node_id, E>>();
+				auto removed = std::vector<std::pair<node_id, E>>();
+				for (auto group = edges.begin(); group != edges.end();) {
+					auto const src = group->src;
+					auto& out = graph_->node_at(src).out;
+					added.clear();
+					removed.clear();
+					while (group != edges.end() && group->src == src) {
+						auto edge = std::make_pair(group->dst, *group->weight);
+						auto const existed = out.find(edge) != out.end();
+						auto present = existed;
+						auto const next = std::find_if(group, edges.end(), [&](pending const& p) {
+							return key_less(*group, p);
+						});
+						for (; group != next; ++group) {
+							auto const insert = ops[group->op].first == op_kind::insert_edge;
+							results[group->op] = insert != present;
+							present = insert;
+						}
+						if (present != existed) {
+							(present ? added : removed).push_back(std::move(edge));
+						}
+					}
+					update_edges(out, removed, added);
+					graph_->edges_removed(src);
+					graph_->edges_added(src);
+					// each destination's reverse index is updated once
+					for (auto it = removed.begin(); it != removed.end(); ++it) {
+						if (std::next(it) != removed.end() && std::next(it)->first == it->first) {
+							continue;
+						}
+						auto const remaining = out.lower_bound(it->first);
+						if (remaining == out.end() || remaining->first != it->first) {
+							graph_->node_at(it->first).in.erase(src);
+						}
+					}
+					for (auto it = added.begin(); it != added.end(); ++it) {
+						if (it == added.begin() || std::prev(it)->first != it->first) {
+							graph_->node_at(it->first).in.insert(src);
+						}
+					}
+				}
+			}
+
+			graph* graph_;
+			std::vector<op> ops_;
+			std::vector<std::pair<N, N>> node_args_;
+			std::vector<std::tuple<N, N, E>> edge_args_;
 		};
 
 	public:
 		// Iterator
-		using iterator = graph<N, E>::iterator;
-		using const_iterator = const graph<N, E>::iterator;
+		using iterator = typename graph::iterator;
+		using const_iterator = const typename graph::iterator;
 		using reverse_iterator = std::reverse_iterator<iterator>;
 		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using connection_view = typename graph::connection_view;
+		// The weights of a run of edges to one destination, as returned by weights_view.
+		using weight_view = std::ranges::elements_view<
+		   std::ranges::subrange<typename adjacency_set::const_iterator>,
+		   1>;
 
+		// O(1) with an ordered node table, otherwise O(number of nodes before the first edge)
 		[[nodiscard]] auto begin() const noexcept -> iterator {
-			// empty graph
-			if (nodes_.get()->empty()) {
-				// default constructed inner_iterator is a NULL/EOF iterator
-				return iterator(nodes_.get()->begin(), {}, nodes_.get()->cend());
+			if constexpr (Storage::ordered) {
+				auto const& first = ids_.get()->first_source;
+				return first ? make_iterator(*first, (*first)->second.out.begin()) : end();
 			}
-			// return the first node with an edge to be used as the start of iterator
-			for (auto it = nodes_.get()->begin(); it != nodes_.get()->end(); ++it) {
-				if (!it->second.empty()) {
-					return iterator(it, it->second.begin(), nodes_.get()->cend());
+			else {
+				// an unordered table's order changes when it rehashes, so the first node with an
+				// edge is searched for
+				if (nodes_.get()->empty()) {
+					// default constructed inner_iterator is a NULL/EOF iterator
+					return make_iterator(nodes_.get()->begin(), {});
 				}
+				for (auto it = nodes_.get()->begin(); it != nodes_.get()->end(); ++it) {
+					if (!it->second.out.empty()) {
+						return make_iterator(it, it->second.out.begin());
+					}
+				}
+				// all nodes had no edge
+				return make_iterator(nodes_.get()->cend(), {});
 			}
-			// all nodes had no edge
-			return iterator(nodes_.get()->cend(), {}, nodes_.get()->cend());
 		}
 
 		auto cbegin() const noexcept -> const_iterator {
-			// empty graph
-			if (nodes_.get()->empty()) {
-				// default constructed inner_iterator is a NULL/EOF iterator
-				return const_iterator(nodes_.get()->begin(), {}, nodes_.get()->cend());
-			}
-			// return the first node with an edge to be used as the start of iterator
-			for (auto it = nodes_.get()->begin(); it != nodes_.get()->end(); ++it) {
-				if (!it->second.empty()) {
-					return const_iterator(it, it->second.begin(), nodes_.get()->cend());
-				}
-			}
-			// all nodes had no edge
-			return const_iterator(nodes_.get()->cend(), {}, nodes_.get()->cend());
+			return begin();
 		}
 
 		[[nodiscard]] auto end() const noexcept -> iterator {
 			// default constructed inner_iterator is a NULL/EOF iterator
-			return iterator(nodes_.get()->cend(), {}, nodes_.get()->cend());
+			return make_iterator(nodes_.get()->cend(), {});
 		}
 
 		auto cend() const noexcept -> const_iterator {
-			// default constructed inner_iterator is a NULL/EOF iterator
-			return const_iterator(nodes_.get()->cend(), {}, nodes_.get()->cend());
+			return end();
 		}
 
+		// Batched modification
+		using mutation_batch = typename graph::mutation_batch;
+
 		// Constructors
 		graph() noexcept {
-			nodes_ = std::make_unique<std::map<N, std::set<std::pair<N, E>>>>();
+			nodes_ = std::make_unique<node_map>();
+			ids_ = std::make_unique<node_ids>();
 		}
-		graph(std::initializer_list<N> list) {
-			nodes_ = std::make_unique<std::map<N, std::set<std::pair<N, E>>>>();
+		graph(std::initializer_list<N> list)
+		: graph() {
 			for (auto const& value : list) {
-				nodes_.get()->insert({value, std::set<std::pair<N, E>>{}});
+				insert_node(value);
 			}
 		}
 		template<typename InputIt>
-		graph(InputIt first, InputIt last) {
-			nodes_ = std::make_unique<std::map<N, std::set<std::pair<N, E>>>>();
+		graph(InputIt first, InputIt last)
+		: graph() {
 			for (auto itr = first; itr != last; ++itr) {
-				nodes_.get()->insert({*itr, std::set<std::pair<N, E>>{}});
+				insert_node(*itr);
 			}
 		}
 		graph(graph&& other) noexcept
-		: nodes_{std::exchange(other.nodes_, graph().nodes_)} {};
+		: nodes_{std::exchange(other.nodes_, std::make_unique<node_map>())}
+		, ids_{std::exchange(other.ids_, std::make_unique<node_ids>())} {};
 
 		auto operator=(graph&& other) noexcept -> graph& {
-			nodes_ = std::exchange(other.nodes_, graph().nodes_);
+			nodes_ = std::exchange(other.nodes_, std::make_unique<node_map>());
+			ids_ = std::exchange(other.ids_, std::make_unique<node_ids>());
 			return *this;
 		}
 
-		graph(graph const& other) noexcept {
-			nodes_ = std::make_unique<std::map<N, std::set<std::pair<N, E>>>>();
-			for (auto it = other.nodes_.get()->begin(); it != other.nodes_.get()->end(); ++it) {
-				nodes_.get()->insert({it->first, it->second});
+		// The copy keeps other's ids, so the edge sets can be copied as they are once every node
+		// exists; only their comparators change to refer to the new id table.
+		graph(graph const& other)
+		: graph() {
+			ids_.get()->entries.resize(other.ids_.get()->entries.size());
+			ids_.get()->free = other.ids_.get()->free;
+			for (auto const& [value, edges] : *other.nodes_.get()) {
+				add_node(value, edges.id);
+			}
+			for (auto const& [value, edges] : *other.nodes_.get()) {
+				auto& copy = node_at(edges.id);
+				copy.out = adjacency_set(edges.out.begin(), edges.out.end(), compare());
+				copy.in = edges.in;
+			}
+			if constexpr (Storage::ordered) {
+				ids_.get()->first_source = next_source(nodes_.get()->cbegin());
 			}
 		}
 		auto operator=(graph const& other) -> graph& {
-			nodes_ = std::make_unique<std::map<N, std::set<std::pair<N, E>>>>();
-			for (auto it = other.nodes_.get()->begin(); it != other.nodes_.get()->end(); ++it) {
-				nodes_.get()->insert({it->first, it->second});
-			}
-			return *this;
+			return *this = graph(other);
 		}
 
 		// Modifiers
@@ -200,28 +572,139 @@ namespace gdwg {
 			if (is_node(value)) {
 				return false;
 			}
-			nodes_.get()->insert({value, std::set<std::pair<N, E>>{}});
+			auto& free = ids_.get()->free;
+			if (free.empty()) {
+				add_node(value, static_cast<node_id>(ids_.get()->entries.size()));
+			}
+			else {
+				add_node(value, free.back());
+				free.pop_back();
+			}
 			return true;
 		}
 
 		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
-			if (is_node(src) && is_node(dst)) {
-				auto edge_set = nodes_.get()->at(src);
-				// insert edge only if edge don't already exist
-				if (std::find(edge_set.begin(), edge_set.end(), std::make_pair(dst, weight))
-				    == edge_set.end()) {
-					nodes_.get()->at(src).insert(std::make_pair(dst, weight));
-					return true;
+			auto src_it = nodes_.get()->find(src);
+			auto dst_it = nodes_.get()->find(dst);
+			if (src_it != nodes_.get()->end() && dst_it != nodes_.get()->end()) {
+				// emplace probes the edge set in place, so the edge is only inserted if it doesn't
+				// already exist and the set is never copied
+				if (!src_it->second.out.emplace(dst_it->second.id, weight).second) {
+					return false;
 				}
-				return false;
+				dst_it->second.in.insert(src_it->second.id);
+				edges_added(src_it->second.id);
+				return true;
 			}
 			throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edge when either src or "
 			                         "dst node does not exist");
 			return false;
 		}
 
+		// Inserts every {src, dst, weight} in [first, last), returning how many were not already
+		// in the graph. The edges are resolved to ids, sorted and deduplicated once, then each
+		// source's run is merged into its edge set in a single pass. Missing nodes are inserted
+		// when insert_missing is set; otherwise nothing is inserted and the same error as
+		// insert_edge is thrown.
+		template<typename InputIt>
+		auto insert_edges(InputIt first, InputIt last, bool insert_missing = false) -> std::size_t {
+			auto edges = std::vector<std::pair<node_id, std::pair<node_id, E>>>();
+			if constexpr (std::forward_iterator<InputIt>) {
+				edges.reserve(static_cast<std::size_t>(std::distance(first, last)));
+			}
+			auto const resolve = [this, insert_missing](auto const& value) -> node_id {
+				auto it = nodes_.get()->find(value);
+				if (it != nodes_.get()->end()) {
+					return it->second.id;
+				}
+				if (!insert_missing) {
+					throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edge when either "
+					                         "src or dst node does not exist");
+				}
+				insert_node(value);
+				return nodes_.get()->find(value)->second.id;
+			};
+			// edge lists are commonly grouped by source, so the last source is remembered
+			auto last_src = std::optional<node_id>();
+			for (auto it = first; it != last; ++it) {
+				auto const& [src, dst, weight] = *it;
+				if (!last_src || !(ids_.get()->name(*last_src) == src)) {
+					last_src = resolve(src);
+				}
+				edges.emplace_back(*last_src, std::make_pair(resolve(dst), weight));
+			}
+
+			// Ranking the destinations by value once lets the edges be sorted with integer compares
+			// instead of comparing node values through the id table
+			auto by_value = std::vector<node_id>();
+			by_value.reserve(edges.size());
+			for (auto const& [src, edge] : edges) {
+				by_value.push_back(edge.first);
+			}
+			std::sort(by_value.begin(), by_value.end());
+			by_value.erase(std::unique(by_value.begin(), by_value.end()), by_value.end());
+			std::sort(by_value.begin(), by_value.end(), [this](node_id lhs, node_id rhs) {
+				return ids_.get()->name(lhs) < ids_.get()->name(rhs);
+			});
+			auto rank = std::vector<node_id>(ids_.get()->entries.size());
+			for (auto i = std::size_t{0}; i < by_value.size(); ++i) {
+				rank[by_value[i]] = static_cast<node_id>(i);
+			}
+			auto const edge_less = [&rank](auto const& lhs, auto const& rhs) {
+				if (lhs.first != rhs.first) {
+					return lhs.first < rhs.first;
+				}
+				if (lhs.second.first != rhs.second.first) {
+					return rank[lhs.second.first] < rank[rhs.second.first];
+				}
+				return lhs.second.second < rhs.second.second;
+			};
+			auto const edge_equal = [&edge_less](auto const& lhs, auto const& rhs) {
+				return !edge_less(lhs, rhs) && !edge_less(rhs, lhs);
+			};
+			std::sort(edges.begin(), edges.end(), edge_less);
+			edges.erase(std::unique(edges.begin(), edges.end(), edge_equal), edges.end());
+
+			auto inserted = std::size_t{0};
+			auto run = std::vector<std::pair<node_id, E>>();
+			auto incoming = std::vector<std::pair<node_id, node_id>>();
+			for (auto group = edges.begin(); group != edges.end();) {
+				auto const src = group->first;
+				run.clear();
+				for (; group != edges.end() && group->first == src; ++group) {
+					if (run.empty() || run.back().first != group->second.first) {
+						incoming.emplace_back(group->second.first, src);
+					}
+					run.push_back(group->second);
+				}
+				auto& out = node_at(src).out;
+				auto const before = out.size();
+				out.insert(run.begin(), run.end());
+				inserted += out.size() - before;
+				edges_added(src);
+			}
+			// the reverse index is filled the same way, one sorted run per destination
+			std::sort(incoming.begin(), incoming.end());
+			auto sources = std::vector<node_id>();
+			for (auto group = incoming.begin(); group != incoming.end();) {
+				auto const dst = group->first;
+				sources.clear();
+				for (; group != incoming.end() && group->first == dst; ++group) {
+					sources.push_back(group->second);
+				}
+				node_at(dst).in.insert(sources.begin(), sources.end());
+			}
+			return inserted;
+		}
+
+		// Starts a batch of modifications to this graph. See mutation_batch.
+		[[nodiscard]] auto batch() noexcept -> mutation_batch {
+			return mutation_batch(*this);
+		}
+
 		auto replace_node(N const& old_data, N const& new_data) -> bool {
-			if (!is_node(old_data)) {
+			auto old_it = nodes_.get()->find(old_data);
+			if (old_it == nodes_.get()->end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::replace_node on a node that "
 				                         "doesn't exist");
 				return false;
@@ -229,212 +712,545 @@ namespace gdwg {
 			if (is_node(new_data)) {
 				return false;
 			}
-			// Rename the old_data key to be the new_data
-			auto node_handler = nodes_.get()->extract(old_data);
-			node_handler.key() = new_data;
-			nodes_.get()->insert(std::move(node_handler));
-
-			// rename any other old_data to new_data in other exisiting edges
-			for (auto it = nodes_.get()->begin(); it != nodes_.get()->end(); ++it) {
-				auto edge_set = nodes_.get()->at(it->first);
-				auto new_edge_set = std::set<std::pair<N, E>>();
-				for (auto& [dst, weight] : edge_set) {
-					if (dst == old_data) {
-						new_edge_set.insert(std::make_pair(new_data, weight));
-					}
-					else {
-						new_edge_set.insert(std::make_pair(dst, weight));
-					}
+			// Edges keep their ids, but the edges into the renamed node must be taken out of each
+			// source's edge set while they are still ordered by old_data
+			auto const id = old_it->second.id;
+			auto moved = std::vector<std::pair<node_id, std::vector<E>>>();
+			for (auto const src : old_it->second.in) {
+				auto& src_out = node_at(src).out;
+				auto const [first, last] = src_out.equal_range(id);
+				auto weights = std::vector<E>();
+				for (auto it = first; it != last; ++it) {
+					weights.push_back(it->second);
 				}
-				nodes_.get()->at(it->first) = new_edge_set;
+				src_out.erase(first, last);
+				moved.emplace_back(src, std::move(weights));
 			}
 
+			// Rename the old_data key to be the new_data. It moves in the node order, so it stops
+			// being the first source until it is back in the table
+			forget_source(old_it);
+			auto node_handler = nodes_.get()->extract(old_it);
+			node_handler.key() = new_data;
+			ids_.get()->entries[id] = &*nodes_.get()->insert(std::move(node_handler)).position;
+
+			for (auto const& [src, weights] : moved) {
+				auto& src_out = node_at(src).out;
+				for (auto const& weight : weights) {
+					src_out.emplace(id, weight);
+				}
+				// the sources were briefly left without these edges
+				edges_added(src);
+			}
+			edges_added(id);
 			return true;
 		}
 
 		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
-			if (!(is_node(old_data) && is_node(new_data))) {
+			auto old_it = nodes_.get()->find(old_data);
+			auto new_it = nodes_.get()->find(new_data);
+			if (old_it == nodes_.get()->end() || new_it == nodes_.get()->end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_node on old or "
 				                         "new data if they don't exist in the graph");
 			}
 			if (old_data == new_data){
 				return;
 			}
-			// For all outgoing edges
-			for (auto& [dst, weight] : nodes_.get()->at(old_data)) {
-				nodes_.get()->at(new_data).insert(std::make_pair(dst, weight));
+			auto& old_node = old_it->second;
+			auto& new_node = new_it->second;
+			// For all outgoing edges, with self loops becoming loops on new_data
+			for (auto const& [dst, weight] : old_node.out) {
+				auto const target = dst == old_node.id ? new_node.id : dst;
+				new_node.out.emplace(target, weight);
+				auto& target_in = node_at(target).in;
+				target_in.erase(old_node.id);
+				target_in.insert(new_node.id);
 			}
-			// remove old node
-			nodes_.get()->erase(old_data);
-			// For all nodes replace outgoing edges with old_node
-			for (auto it = nodes_.get()->begin(); it != nodes_.get()->end(); ++it) {
-				auto edge_set = nodes_.get()->at(it->first);
-				auto new_edge_set = std::set<std::pair<N, E>>();
-				for (auto& [dst, weight] : edge_set) {
-					if (dst == old_data) {
-						new_edge_set.insert(std::make_pair(new_data, weight));
-					}
-					else {
-						new_edge_set.insert(std::make_pair(dst, weight));
-					}
+			edges_added(new_node.id);
+			// For all other nodes with an edge into old_data, point those edges at new_data
+			for (auto const src : old_node.in) {
+				if (src != old_node.id) {
+					redirect_edges(node_at(src).out, old_node.id, new_node.id);
+					new_node.in.insert(src);
 				}
-				nodes_.get()->at(it->first) = new_edge_set;
 			}
+			// remove old node
+			remove_node(old_it);
 		}
 		auto erase_node(N const& value) -> bool {
-			auto value_removed = nodes_.get()->erase(value);
-			// For all nodes and it's edges replace it with a copy of it's edge without the old node
-			for (auto it = nodes_.get()->begin(); it != nodes_.get()->end(); ++it) {
-				auto edge_set = nodes_.get()->at(it->first);
-				auto new_edge_set = std::set<std::pair<N, E>>();
-				for (auto& [dst, weight] : edge_set) {
-					if (dst != value) {
-						new_edge_set.insert(std::make_pair(dst, weight));
-					}
+			auto value_it = nodes_.get()->find(value);
+			if (value_it == nodes_.get()->end()) {
+				return false;
+			}
+			// Only the neighbours of value refer to it, so only they need their edges updated
+			auto const id = value_it->second.id;
+			for (auto const& [dst, weight] : value_it->second.out) {
+				if (dst != id) {
+					node_at(dst).in.erase(id);
+				}
+			}
+			for (auto const src : value_it->second.in) {
+				if (src != id) {
+					auto& src_out = node_at(src).out;
+					auto const [first, last] = src_out.equal_range(id);
+					src_out.erase(first, last);
+					edges_removed(src);
 				}
-				nodes_.get()->at(it->first) = new_edge_set;
 			}
-			return value_removed;
+			remove_node(value_it);
+			return true;
 		}
 
 		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
-			if (!(is_node(src) && is_node(dst))) {
+			auto src_it = nodes_.get()->find(src);
+			auto dst_it = nodes_.get()->find(dst);
+			if (src_it == nodes_.get()->end() || dst_it == nodes_.get()->end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edge on src or dst if "
 				                         "they don't exist in the graph");
 				return false;
 			}
-			auto edge_removed = false;
-			auto edge_set = nodes_.get()->at(src);
-			auto new_edge_set = std::set<std::pair<N, E>>();
-			for (auto& [e_dst, e_weight] : edge_set) {
-				if (e_dst == dst && e_weight == weight) {
-					edge_removed = true;
-				}
-				else {
-					new_edge_set.insert(std::make_pair(e_dst, e_weight));
-				}
+			// the edge is looked up and erased in place, O(log deg) with std::set edge sets
+			auto& out = src_it->second.out;
+			auto const edge = out.find(std::make_pair(dst_it->second.id, weight));
+			if (edge == out.end()) {
+				return false;
 			}
-			nodes_.get()->at(src) = new_edge_set;
-			return edge_removed;
+			if (is_last_edge_to(out, edge)) {
+				dst_it->second.in.erase(src_it->second.id);
+			}
+			out.erase(edge);
+			edges_removed(src_it->second.id);
+			return true;
 		}
 
 		auto erase_edge(iterator i) noexcept -> iterator {
 			if (i == end()) {
 				return end();
 			}
-			auto next = std::next(i);
 			// make iterator unconstant to allow erase to modify.
 			// It's O(1) as the erase is call on a range of 1.
 			auto unconst_it = nodes_.get()->erase(i.outer_, i.outer_);
-			unconst_it->second.erase(i.inner_);
-			return iterator(next.outer_, next.inner_, nodes_.get()->end());
+			auto& out = unconst_it->second.out;
+			if (is_last_edge_to(out, i.inner_)) {
+				node_at(i.inner_->first).in.erase(unconst_it->second.id);
+			}
+			// the next edge is taken from erase itself, as with vector backed edge sets erasing
+			// invalidates the iterators after i
+			auto next = make_iterator(i.outer_, out.erase(i.inner_));
+			edges_removed(unconst_it->second.id);
+			if (next.inner_ == out.cend()) {
+				++next;
+			}
+			return next;
 		}
 
 		auto erase_edge(iterator i, iterator s) noexcept -> iterator {
-			while (i != s) {
+			// count first, erasing may invalidate s
+			for (auto count = std::distance(i, s); count > 0; --count) {
 				i = erase_edge(i);
 			}
-			if (s != end()) {
-				++s;
+			if (i != end()) {
+				++i;
 			}
-			return iterator(s.outer_, s.inner_, nodes_.get()->end());
+			return i;
 		}
 
 		auto clear() noexcept -> void {
 			nodes_.get()->clear();
+			ids_.get()->entries.clear();
+			ids_.get()->free.clear();
+			ids_.get()->first_source.reset();
 		}
 
 		// Accessors
-		[[nodiscard]] auto is_node(N const& value) noexcept -> bool {
+		[[nodiscard]] auto is_node(N const& value) const noexcept -> bool {
 			return (nodes_.get()->find(value) != nodes_.get()->end());
 		}
-		[[nodiscard]] auto empty() noexcept -> bool {
+		[[nodiscard]] auto empty() const noexcept -> bool {
 			return (nodes_.get()->empty());
 		}
-		[[nodiscard]] auto is_connected(N const& src, N const& dst) -> bool {
-			if (!(is_node(src) && is_node(dst))) {
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			auto const src_it = nodes_.get()->find(src);
+			auto const dst_it = nodes_.get()->find(dst);
+			if (src_it == nodes_.get()->end() || dst_it == nodes_.get()->end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_node on old or "
 				                         "new data if they don't exist in the graph");
-				return false;
-			}
-			for (auto& [edg_dst, weight] : nodes_.get()->at(src)) {
-				if (edg_dst == dst) {
-					return true;
-				}
 			}
-			return false;
+			auto const& out = src_it->second.out;
+			auto const edge = out.lower_bound(dst_it->second.id);
+			return edge != out.end() && edge->first == dst_it->second.id;
 		}
-		[[nodiscard]] auto nodes() -> std::vector<N> {
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
 			std::vector<N> vec;
 			std::transform(nodes_.get()->begin(),
 			               nodes_.get()->end(),
 			               std::back_inserter(vec),
 			               [](auto& map) { return map.first; });
+			if constexpr (!Storage::ordered) {
+				std::sort(vec.begin(), vec.end());
+			}
 			return vec;
 		}
-		[[nodiscard]] auto weights(N const& src, N const& dst) -> std::vector<E> {
-			if (!(is_node(src) && is_node(dst))) {
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			auto const view = weights_view(src, dst);
+			return std::vector<E>(view.begin(), view.end());
+		}
+		// The weights of the edges from src to dst in ascending order, like weights, but read in
+		// place rather than copied into a vector. The view is invalidated along with iterators to
+		// src's edges.
+		[[nodiscard]] auto weights_view(N const& src, N const& dst) const -> weight_view {
+			auto const src_it = nodes_.get()->find(src);
+			auto const dst_it = nodes_.get()->find(dst);
+			if (src_it == nodes_.get()->end() || dst_it == nodes_.get()->end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights if src or dst node "
 				                         "don't exist in the graph");
 			}
-			std::vector<E> vec;
-			for (auto& [edg_dst, weight] : nodes_.get()->at(src)) {
-				if (edg_dst == dst) {
-					vec.push_back(weight);
-				}
-			}
-			return vec;
+			auto const [first, last] = src_it->second.out.equal_range(dst_it->second.id);
+			return weight_view(std::ranges::subrange(first, last));
 		}
 
-		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) noexcept -> iterator {
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const noexcept
+		   -> iterator {
 			auto outer = nodes_.get()->find(src);
-			if (outer == nodes_.get()->end()) {
+			auto dst_it = nodes_.get()->find(dst);
+			if (outer == nodes_.get()->end() || dst_it == nodes_.get()->end()) {
 				return end();
 			}
-			auto inner = outer->second.find(std::make_pair(dst, weight));
-			if (inner != outer->second.end()) {
-				return iterator(outer, inner, nodes_.get()->cend());
+			auto inner = outer->second.out.find(std::make_pair(dst_it->second.id, weight));
+			if (inner != outer->second.out.end()) {
+				return make_iterator(outer, inner);
 			}
 			return end();
 		}
 
-		[[nodiscard]] auto connections(N const& src) -> std::vector<N> {
-			if (!is_node(src)) {
-				throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections if src doesn't "
-				                         "exist in the graph");
-			}
-			auto edge_set = nodes_.get()->at(src);
-			std::set<N> uni_edge;
-			for (auto& [edg_dst, weight] : nodes_.get()->at(src)) {
-				uni_edge.insert(edg_dst);
-			}
-			return std::vector<N>(uni_edge.begin(), uni_edge.end());
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto const view = connections_view(src);
+			return std::vector<N>(view.begin(), view.end());
+		}
+		// The same destinations as connections, without copying them or allocating.
+		[[nodiscard]] auto connections_view(N const& src) const -> connection_view {
+			static_assert(std::ranges::view<connection_view>);
+			auto const& out = out_edges(src, "connections");
+			return connection_view(out.begin(), out.end(), ids_.get());
+		}
+		// The number of edges leaving src, counting each weight to the same destination.
+		[[nodiscard]] auto out_degree(N const& src) const -> std::size_t {
+			return out_edges(src, "out_degree").size();
+		}
+		// The number of distinct destinations of src's edges, which connections would return.
+		// O(out_degree(src)), without allocating.
+		[[nodiscard]] auto distinct_out_degree(N const& src) const -> std::size_t {
+			auto const& out = out_edges(src, "distinct_out_degree");
+			auto const view = connection_view(out.begin(), out.end(), ids_.get());
+			return static_cast<std::size_t>(std::distance(view.begin(), view.end()));
 		}
 
 		// Comparisons
+		// Ids depend on insertion history, so edges are compared by the values they refer to.
 		[[nodiscard]] auto operator==(graph const& other) const -> bool {
-			return (
-			   nodes_.get()->size() == other.nodes_.get()->size()
-			   && std::equal(nodes_.get()->begin(), nodes_.get()->end(), other.nodes_.get()->begin()));
+			if (nodes_.get()->size() != other.nodes_.get()->size()) {
+				return false;
+			}
+			auto const same_edge = [this, &other](auto const& lhs, auto const& rhs) {
+				return lhs.second == rhs.second
+				       && ids_.get()->name(lhs.first) == other.ids_.get()->name(rhs.first);
+			};
+			for (auto const& [value, edges] : *nodes_.get()) {
+				auto const other_it = other.nodes_.get()->find(value);
+				if (other_it == other.nodes_.get()->end()
+				    || edges.out.size() != other_it->second.out.size()
+				    || !std::equal(edges.out.begin(),
+				                   edges.out.end(),
+				                   other_it->second.out.begin(),
+				                   same_edge))
+				{
+					return false;
+				}
+			}
+			return true;
 		}
 
 		// Extractor
+		// Each line ends in '\n' and os is flushed once at the end, rather than by std::endl on
+		// every line. Numbers and strings are written through a buffer when os would print them
+		// exactly as to_chars does, so a large graph costs a handful of writes.
 		friend auto operator<<(std::ostream& os, graph const& g) noexcept -> std::ostream& {
+			if constexpr (detail::text_value<N> && detail::text_value<E>) {
+				if (detail::plain_text_stream(os)) {
+					g.write_text(os);
+					return os.flush();
+				}
+			}
 			for (auto it = g.nodes_.get()->begin(); it != g.nodes_.get()->end(); ++it) {
-				os << it->first << " (" << std::endl;
-				for (auto const& [to, weight] : it->second) {
-					os << "  " << to << " | " << weight << std::endl;
+				os << it->first << " (\n";
+				for (auto const& [to, weight] : it->second.out) {
+					os << "  " << g.ids_.get()->name(to) << " | " << weight << '\n';
 				}
-				os << ")" << std::endl;
+				os << ")\n";
 			}
-			return os;
+			return os.flush();
 		}
 
 	private:
+		// The text operator<< writes, formatted into a block at a time and handed to os whole.
+		auto write_text(std::ostream& os) const -> void {
+			constexpr auto block = std::size_t{1} << 16;
+			auto const precision = os.precision();
+			auto buffer = std::string();
+			buffer.reserve(block + 1024);
+			auto const flush = [&os, &buffer] {
+				os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+				buffer.clear();
+			};
+			for (auto const& [value, edges] : *nodes_.get()) {
+				detail::append_text(buffer, value, precision);
+				buffer += " (\n";
+				for (auto const& [to, weight] : edges.out) {
+					buffer += "  ";
+					detail::append_text(buffer, ids_.get()->name(to), precision);
+					buffer += " | ";
+					detail::append_text(buffer, weight, precision);
+					buffer += '\n';
+					if (buffer.size() >= block) {
+						flush();
+					}
+				}
+				buffer += ")\n";
+				if (buffer.size() >= block) {
+					flush();
+				}
+			}
+			flush();
+		}
+
+		auto make_iterator(typename node_map::const_iterator outer,
+		                   typename adjacency_set::const_iterator inner) const noexcept -> iterator {
+			return iterator(outer, inner, nodes_.get()->cend(), ids_.get());
+		}
+
+		auto compare() const noexcept -> edge_compare {
+			return edge_compare{ids_.get()};
+		}
+
+		auto node_at(node_id id) const noexcept -> node_edges& {
+			return ids_.get()->entries[id]->second;
+		}
+
+		// The edges leaving src, throwing on behalf of function if src isn't a node.
+		auto out_edges(N const& src, char const* function) const -> adjacency_set const& {
+			auto const it = nodes_.get()->find(src);
+			if (it == nodes_.get()->end()) {
+				throw std::runtime_error(std::string("Cannot call gdwg::graph<N, E>::") + function
+				                         + " if src doesn't exist in the graph");
+			}
+			return it->second.out;
+		}
+
+		// Inserts value under the given unused id.
+		auto add_node(N const& value, node_id id) -> void {
+			auto& entries = ids_.get()->entries;
+			if (id >= entries.size()) {
+				entries.resize(id + std::size_t{1});
+			}
+			auto const [it, inserted] =
+			   nodes_.get()->emplace(value, node_edges{adjacency_set(compare()), {}, id});
+			entries[id] = &*it;
+		}
+
+		// Erases the node at it and releases its id for reuse.
+		auto remove_node(typename node_map::iterator it) -> void {
+			forget_source(it);
+			auto const id = it->second.id;
+			nodes_.get()->erase(it);
+			ids_.get()->entries[id] = nullptr;
+			ids_.get()->free.push_back(id);
+		}
+
+		// Keeps first_source up to date after the node id may have gained its first edge.
+		auto edges_added(node_id id) -> void {
+			if constexpr (Storage::ordered) {
+				auto& first = ids_.get()->first_source;
+				auto const& value = ids_.get()->name(id);
+				if (!node_at(id).out.empty() && (!first || value < (*first)->first)) {
+					first = nodes_.get()->find(value);
+				}
+			}
+		}
+
+		// Keeps first_source up to date after the node id may have lost its last edge.
+		auto edges_removed(node_id id) noexcept -> void {
+			if constexpr (Storage::ordered) {
+				auto& first = ids_.get()->first_source;
+				if (first && (*first)->second.id == id && (*first)->second.out.empty()) {
+					first = next_source(std::next(*first));
+				}
+			}
+		}
+
+		// Moves first_source past it, before it is erased or re-keyed.
+		auto forget_source(typename node_map::const_iterator it) noexcept -> void {
+			if constexpr (Storage::ordered) {
+				auto& first = ids_.get()->first_source;
+				if (first && *first == it) {
+					first = next_source(std::next(it));
+				}
+			}
+		}
+
+		// The first node at or after it with an outgoing edge.
+		auto next_source(typename node_map::const_iterator it) const noexcept
+		   -> std::optional<typename node_map::const_iterator> {
+			while (it != nodes_.get()->cend() && it->second.out.empty()) {
+				++it;
+			}
+			if (it == nodes_.get()->cend()) {
+				return std::nullopt;
+			}
+			return it;
+		}
+
+		// Re-targets every edge in out that points at from so it points at to instead.
+		static auto redirect_edges(adjacency_set& out, node_id from, node_id to) -> void {
+			auto const [first, last] = out.equal_range(from);
+			auto weights = std::vector<E>();
+			for (auto it = first; it != last; ++it) {
+				weights.push_back(it->second);
+			}
+			out.erase(first, last);
+			for (auto const& weight : weights) {
+				out.emplace(to, weight);
+			}
+		}
+
+		// Erases removed from out and inserts added. A set with replace, as flat_set has, takes
+		// both in one merge pass once they are sorted into its order, which keeps the edges to
+		// one destination adjacent; otherwise each is erased in O(log deg).
+		static auto update_edges(adjacency_set& out,
+		                         std::vector<std::pair<node_id, E>>& removed,
+		                         std::vector<std::pair<node_id, E>>& added) -> void {
+			if constexpr (requires {
+				              out.replace(removed.begin(), removed.end(), added.begin(), added.end());
+			              })
+			{
+				std::sort(removed.begin(), removed.end(), out.key_comp());
+				std::sort(added.begin(), added.end(), out.key_comp());
+				out.replace(removed.begin(), removed.end(), added.begin(), added.end());
+			}
+			else {
+				for (auto const& edge : removed) {
+					out.erase(out.find(edge));
+				}
+				out.insert(added.begin(), added.end());
+			}
+		}
+
+		// Whether edge is the only edge in out going to its destination.
+		static auto is_last_edge_to(adjacency_set const& out,
+		                            typename adjacency_set::const_iterator edge) -> bool {
+			auto const next = std::next(edge);
+			if (next != out.end() && next->first == edge->first) {
+				return false;
+			}
+			return edge == out.begin() || std::prev(edge)->first != edge->first;
+		}
+
 		// internal structure
-		std::unique_ptr<std::map<N, std::set<std::pair<N, E>>>> nodes_;
+		std::unique_ptr<node_map> nodes_;
+		std::unique_ptr<node_ids> ids_;
 	};
 
+	// Builds the graph whose operator<< text is text. Values are read back as a stream with
+	// default settings would write them, so floating point weights come back as rounded to the
+	// precision they were written with. An edge line is split at its last " | " when weights
+	// are numbers, and so can't contain one, and at its first otherwise. Every node is inserted
+	// before the edges, which go through insert_edges in one batch.
+	template<typename N, typename E, typename Storage = ordered_storage>
+	auto parse_graph(std::string_view text) -> graph<N, E, Storage> {
+		auto nodes = std::vector<N>();
+		auto edges = std::vector<std::tuple<N, N, E>>();
+		auto line_number = std::size_t{0};
+		auto const malformed = [&line_number] {
+			return std::runtime_error("Cannot parse gdwg::graph<N, E> from text with a malformed "
+			                          "line "
+			                          + std::to_string(line_number));
+		};
+		auto in_node = false;
+		while (!text.empty()) {
+			++line_number;
+			auto const newline = text.find('\n');
+			auto const line = text.substr(0, newline);
+			text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+			if (!in_node) {
+				if (!line.ends_with(" (")) {
+					throw malformed();
+				}
+				auto& node = nodes.emplace_back();
+				if (!detail::parse_text(line.substr(0, line.size() - 2), node)) {
+					throw malformed();
+				}
+				in_node = true;
+			}
+			else if (line == ")") {
+				in_node = false;
+			}
+			else {
+				auto const bar = std::is_arithmetic_v<E> ? line.rfind(" | ") : line.find(" | ");
+				if (!line.starts_with("  ") || bar == std::string_view::npos || bar < 2) {
+					throw malformed();
+				}
+				auto& edge = edges.emplace_back(nodes.back(), N(), E());
+				if (!detail::parse_text(line.substr(2, bar - 2), std::get<1>(edge))
+				    || !detail::parse_text(line.substr(bar + 3), std::get<2>(edge)))
+				{
+					throw malformed();
+				}
+			}
+		}
+		if (in_node) {
+			++line_number;
+			throw malformed();
+		}
+
+		auto g = graph<N, E, Storage>(nodes.begin(), nodes.end());
+		try {
+			g.insert_edges(edges.begin(), edges.end());
+		} catch (std::runtime_error const&) {
+			throw std::runtime_error("Cannot parse gdwg::graph<N, E> from text with an edge to a "
+			                         "node it doesn't list");
+		}
+		return g;
+	}
+
+	// Reads the rest of is as the text operator<< writes, replacing g. If the text is malformed,
+	// or there is none, failbit is set and g is left as it was.
+	template<typename N, typename E, typename Storage>
+	auto operator>>(std::istream& is, graph<N, E, Storage>& g) -> std::istream& {
+		constexpr auto block = std::size_t{1} << 16;
+		auto text = std::string();
+		auto const sentry = std::istream::sentry(is, true);
+		if (!sentry) {
+			return is;
+		}
+		do {
+			auto const size = text.size();
+			text.resize(size + block);
+			is.read(text.data() + size, static_cast<std::streamsize>(block));
+			text.resize(size + static_cast<std::size_t>(is.gcount()));
+		} while (is);
+		if (is.bad()) {
+			return is;
+		}
+		is.clear(text.empty() ? std::ios::eofbit | std::ios::failbit : std::ios::eofbit);
+		if (text.empty()) {
+			return is;
+		}
+		try {
+			g = parse_graph<N, E, Storage>(text);
+		} catch (std::runtime_error const&) {
+			is.setstate(std::ios::failbit);
+		}
+		return is;
+	}
 } // namespace gdwg
 
 #endif // GDWG_GRAPH_HPP
@@ -0,0 +1,613 @@
+#ifndef GDWG_SNAPSHOT_HPP
+#define GDWG_SNAPSHOT_HPP
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/detail/mapped_file.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// Binary snapshots: a csr_graph written to disk in a form that can be used in place once
+	// mapped back into memory, so loading one costs nothing up front and pages are read as they
+	// are first touched.
+	//
+	// A snapshot is a fixed header followed by sections, each starting on a 64-byte boundary:
+	//     nodes      every node in ascending order, as N; or for std::string nodes, node_count + 1
+	//                uint64 offsets into the strings section, where node u is the bytes
+	//                [offsets[u], offsets[u + 1])
+	//     strings    the characters of every std::string node, back to back
+	//     offsets    node_count + 1 uint64, as csr_graph::offsets()
+	//     targets    edge_count uint32, as csr_graph::targets()
+	//     weights    edge_count E, as csr_graph::edge_weights()
+	// Values are stored in the writer's byte order, which the header records so a snapshot from
+	// a machine of the other byte order is refused rather than misread.
+
+	// Node types a snapshot can hold: std::string, or trivially copyable and ordered.
+	template<typename N>
+	concept snapshot_node = std::same_as<N, std::string>
+	                        || (std::is_trivially_copyable_v<N> && std::totally_ordered<N>);
+
+	template<typename E>
+	concept snapshot_weight = std::is_trivially_copyable_v<E>;
+
+	namespace detail {
+		// Recorded for nodes and weights alongside their size, so that a snapshot is only loaded
+		// as the types it was written with, or ones laid out identically.
+		enum class snapshot_kind : std::uint32_t {
+			bytes,
+			signed_integer,
+			unsigned_integer,
+			floating_point,
+			string,
+		};
+
+		template<typename T>
+		constexpr auto snapshot_kind_of() noexcept -> snapshot_kind {
+			if constexpr (std::same_as<T, std::string>) {
+				return snapshot_kind::string;
+			}
+			else if constexpr (std::is_floating_point_v<T>) {
+				return snapshot_kind::floating_point;
+			}
+			else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+				return snapshot_kind::signed_integer;
+			}
+			else if constexpr (std::is_integral_v<T>) {
+				return snapshot_kind::unsigned_integer;
+			}
+			else {
+				return snapshot_kind::bytes;
+			}
+		}
+
+		struct snapshot_header {
+			static constexpr auto expected_magic =
+			   std::array<char, 8>{'G', 'D', 'W', 'G', 'S', 'N', 'A', 'P'};
+			static constexpr auto current_version = std::uint32_t{1};
+			static constexpr auto native_byte_order = std::uint32_t{0x01020304};
+			static constexpr auto alignment = std::uint64_t{64};
+
+			std::array<char, 8> magic = expected_magic;
+			std::uint32_t byte_order = native_byte_order;
+			std::uint32_t version = current_version;
+			snapshot_kind node_kind = snapshot_kind::bytes;
+			std::uint32_t node_size = 0;
+			snapshot_kind weight_kind = snapshot_kind::bytes;
+			std::uint32_t weight_size = 0;
+			std::uint64_t node_count = 0;
+			std::uint64_t edge_count = 0;
+			// the byte offset of each section from the start of the file
+			std::uint64_t nodes = 0;
+			std::uint64_t strings = 0;
+			std::uint64_t strings_size = 0;
+			std::uint64_t offsets = 0;
+			std::uint64_t targets = 0;
+			std::uint64_t weights = 0;
+			std::uint64_t file_size = 0;
+			// of every section, in order, without the padding between them
+			std::uint64_t checksum = 0;
+		};
+		static_assert(std::is_trivially_copyable_v<snapshot_header>);
+
+		// 64-bit FNV-1a over whole words rather than bytes, which detects corruption at memory
+		// speed. Not meant to resist deliberate tampering.
+		inline auto snapshot_checksum(std::span<std::byte const> bytes, std::uint64_t hash) noexcept
+		   -> std::uint64_t {
+			constexpr auto prime = std::uint64_t{0x100000001b3};
+			auto i = std::size_t{0};
+			for (; i + sizeof(std::uint64_t) <= bytes.size(); i += sizeof(std::uint64_t)) {
+				auto word = std::uint64_t{0};
+				std::memcpy(&word, bytes.data() + i, sizeof(word));
+				hash = (hash ^ word) * prime;
+			}
+			for (; i < bytes.size(); ++i) {
+				hash = (hash ^ static_cast<std::uint64_t>(bytes[i])) * prime;
+			}
+			return hash;
+		}
+
+		constexpr auto snapshot_checksum_seed = std::uint64_t{0xcbf29ce484222325};
+
+		constexpr auto align_snapshot_offset(std::uint64_t offset) noexcept -> std::uint64_t {
+			auto const alignment = snapshot_header::alignment;
+			return (offset + alignment - 1) / alignment * alignment;
+		}
+	} // namespace detail
+
+	// Writes g as a snapshot at path. The snapshot is written beside path and renamed over it
+	// once complete, so a reader never maps a half-written file.
+	template<snapshot_node N, snapshot_weight E>
+	auto write_snapshot(csr_graph<N, E> const& g, std::filesystem::path const& path) -> void {
+		using detail::snapshot_header;
+		auto const node_count = static_cast<std::uint64_t>(g.node_count());
+		auto const edge_count = static_cast<std::uint64_t>(g.edge_count());
+
+		// the node section, which for strings is their offsets into the strings section
+		auto const nodes = g.nodes();
+		auto string_offsets = std::vector<std::uint64_t>{0};
+		auto strings = std::string();
+		if constexpr (std::same_as<N, std::string>) {
+			for (auto const& value : nodes) {
+				strings += value;
+				string_offsets.push_back(strings.size());
+			}
+		}
+		auto const node_section = [&] {
+			if constexpr (std::same_as<N, std::string>) {
+				return std::as_bytes(std::span(string_offsets));
+			}
+			else {
+				return std::as_bytes(std::span(nodes));
+			}
+		}();
+		auto const offsets = std::vector<std::uint64_t>(g.offsets().begin(), g.offsets().end());
+
+		auto const sections = std::array<std::span<std::byte const>, 5>{
+		   node_section,
+		   std::as_bytes(std::span(strings)),
+		   std::as_bytes(std::span(offsets)),
+		   std::as_bytes(g.targets()),
+		   std::as_bytes(g.edge_weights()),
+		};
+		auto header = snapshot_header();
+		header.node_kind = detail::snapshot_kind_of<N>();
+		header.node_size = sizeof(N);
+		header.weight_kind = detail::snapshot_kind_of<E>();
+		header.weight_size = sizeof(E);
+		header.node_count = node_count;
+		header.edge_count = edge_count;
+		header.strings_size = strings.size();
+		auto starts = std::array<std::uint64_t, sections.size()>();
+		auto end = static_cast<std::uint64_t>(sizeof(snapshot_header));
+		header.checksum = detail::snapshot_checksum_seed;
+		for (auto i = std::size_t{0}; i < sections.size(); ++i) {
+			starts[i] = detail::align_snapshot_offset(end);
+			end = starts[i] + sections[i].size();
+			header.checksum = detail::snapshot_checksum(sections[i], header.checksum);
+		}
+		header.nodes = starts[0];
+		header.strings = starts[1];
+		header.offsets = starts[2];
+		header.targets = starts[3];
+		header.weights = starts[4];
+		header.file_size = end;
+
+		auto partial = path;
+		partial += ".partial";
+		{
+			auto out = std::ofstream(partial, std::ios::binary | std::ios::trunc);
+			auto const write = [&out](std::span<std::byte const> bytes) {
+				out.write(reinterpret_cast<char const*>(bytes.data()),
+				          static_cast<std::streamsize>(bytes.size()));
+			};
+			write(std::as_bytes(std::span(&header, 1)));
+			auto written = static_cast<std::uint64_t>(sizeof(snapshot_header));
+			auto const padding = std::array<std::byte, snapshot_header::alignment>();
+			for (auto i = std::size_t{0}; i < sections.size(); ++i) {
+				write(std::span(padding).first(starts[i] - written));
+				write(sections[i]);
+				written = starts[i] + sections[i].size();
+			}
+			out.close();
+			if (!out) {
+				std::filesystem::remove(partial);
+				throw std::runtime_error("Cannot call gdwg::write_snapshot on a file that can't be "
+				                         "written");
+			}
+		}
+		std::filesystem::rename(partial, path);
+	}
+
+	// Writes a snapshot of g at path.
+	template<snapshot_node N, snapshot_weight E, typename Storage>
+	auto write_snapshot(graph<N, E, Storage> const& g, std::filesystem::path const& path) -> void {
+		write_snapshot(csr_graph<N, E>(g), path);
+	}
+
+	// A read-only graph used in place from a snapshot file, with csr_graph's dense id interface.
+	// Opening one maps the file and checks its header, in constant time whatever the size of
+	// the graph; nodes and edges are paged in by the operating system as they are first used.
+	// std::string nodes are handed out as std::string_view into the mapping.
+	//
+	// Iteration, find, connections and weights follow csr_graph, and so do the dense id
+	// accessors, so the algorithms run on a mapped_graph directly.
+	//
+	// Only the header is checked when opening, so a snapshot damaged in a way that keeps its
+	// header consistent can give wrong answers or read out of bounds. verify() reads the whole
+	// file to rule that out, when the cost is worth it.
+	template<snapshot_node N, snapshot_weight E>
+	class mapped_graph {
+	public:
+		using node_id = std::uint32_t;
+		// what node() returns
+		using node_reference =
+		   std::conditional_t<std::same_as<N, std::string>, std::string_view, N const&>;
+		using node_type = N;
+		using weight_type = E;
+
+	private:
+		struct value_type {
+			N from;
+			N to;
+			E weight;
+		};
+		// Refers into the mapping, like csr_graph's iterator reference.
+		struct edge_reference {
+			node_reference from;
+			node_reference to;
+			E const& weight;
+
+			operator value_type() const {
+				return value_type{N(from), N(to), weight};
+			}
+		};
+		struct edge_pointer {
+			edge_reference ref;
+
+			auto operator->() const noexcept -> edge_reference const* {
+				return &ref;
+			}
+		};
+		class iterator {
+		public:
+			using value_type = mapped_graph<N, E>::value_type;
+			using reference = edge_reference;
+			using pointer = edge_pointer;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			// Iterator constructor
+			explicit iterator() = default;
+
+			explicit iterator(mapped_graph const* g, node_id src, std::size_t edge)
+			: graph_(g)
+			, src_(src)
+			, edge_(edge) {}
+
+			// Iterator source
+			auto operator*() const noexcept -> reference {
+				return reference{graph_->node(src_),
+				                 graph_->node(graph_->targets_[edge_]),
+				                 graph_->weights_[edge_]};
+			}
+			auto operator->() const noexcept -> pointer {
+				return pointer{**this};
+			}
+
+			// Iterator traversal
+			auto operator++() -> iterator& {
+				++edge_;
+				// skips nodes with no edges
+				while (src_ < graph_->node_count() && edge_ == graph_->offsets_[src_ + 1]) {
+					++src_;
+				}
+				return *this;
+			}
+			auto operator++(int) -> iterator {
+				auto ret = *this;
+				++*this;
+				return ret;
+			}
+			auto operator--() -> iterator& {
+				--edge_;
+				// skips nodes with no edges
+				while (edge_ < graph_->offsets_[src_]) {
+					--src_;
+				}
+				return *this;
+			}
+			auto operator--(int) -> iterator {
+				auto ret = *this;
+				--*this;
+				return ret;
+			}
+
+			// Iterator comparison
+			auto operator==(iterator const& other) const -> bool {
+				return edge_ == other.edge_;
+			}
+
+		private:
+			mapped_graph const* graph_ = nullptr;
+			node_id src_ = 0;
+			std::size_t edge_ = 0;
+		};
+
+	public:
+		// Iterator
+		using iterator = mapped_graph<N, E>::iterator;
+		using const_iterator = const mapped_graph<N, E>::iterator;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		[[nodiscard]] auto begin() const noexcept -> iterator {
+			auto src = node_id{0};
+			while (src < node_count() && offsets_[src + 1] == 0) {
+				++src;
+			}
+			return iterator(this, src, 0);
+		}
+		[[nodiscard]] auto end() const noexcept -> iterator {
+			return iterator(this, node_count(), edge_count());
+		}
+		auto cbegin() const noexcept -> const_iterator {
+			return begin();
+		}
+		auto cend() const noexcept -> const_iterator {
+			return end();
+		}
+
+		// Constructors
+		explicit mapped_graph(std::filesystem::path const& path)
+		: file_(path, "gdwg::mapped_graph<N, E>") {
+			auto const bytes = file_.bytes();
+			if (bytes.size() < sizeof(detail::snapshot_header)) {
+				fail("from a file that isn't a graph snapshot");
+			}
+			std::memcpy(&header_, bytes.data(), sizeof(header_));
+			if (header_.magic != detail::snapshot_header::expected_magic) {
+				fail("from a file that isn't a graph snapshot");
+			}
+			if (header_.byte_order != detail::snapshot_header::native_byte_order) {
+				fail("from a snapshot written with a different byte order");
+			}
+			if (header_.version != detail::snapshot_header::current_version) {
+				fail("from a snapshot written by a different version");
+			}
+			if (header_.node_kind != detail::snapshot_kind_of<N>() || header_.node_size != sizeof(N)
+			    || header_.weight_kind != detail::snapshot_kind_of<E>()
+			    || header_.weight_size != sizeof(E))
+			{
+				fail("from a snapshot of a different node or weight type");
+			}
+			if (header_.file_size != bytes.size() || header_.node_count > max_nodes) {
+				fail("from a truncated or damaged snapshot");
+			}
+			auto const n = header_.node_count;
+			auto const m = header_.edge_count;
+			if constexpr (std::same_as<N, std::string>) {
+				string_offsets_ = section<std::uint64_t>(header_.nodes, n + 1);
+				strings_ = section<char>(header_.strings, header_.strings_size);
+			}
+			else {
+				nodes_ = section<N>(header_.nodes, n);
+			}
+			offsets_ = section<std::uint64_t>(header_.offsets, n + 1);
+			targets_ = section<node_id>(header_.targets, m);
+			weights_ = section<E>(header_.weights, m);
+		}
+
+		// Whether every section still matches the checksum it was written with, and every
+		// offset and target stays within the section it indexes. Once it returns true, no query
+		// reads outside the mapping, even on a file damaged or written by something else whose
+		// checksum happens to match. Reads the whole file.
+		[[nodiscard]] auto verify() const -> bool {
+			auto hash = detail::snapshot_checksum_seed;
+			hash = detail::snapshot_checksum(node_section(), hash);
+			hash = detail::snapshot_checksum(std::as_bytes(strings_), hash);
+			hash = detail::snapshot_checksum(std::as_bytes(offsets_), hash);
+			hash = detail::snapshot_checksum(std::as_bytes(targets_), hash);
+			hash = detail::snapshot_checksum(std::as_bytes(weights_), hash);
+			if (hash != header_.checksum || !ascending_from_zero(offsets_, edge_count())) {
+				return false;
+			}
+			if constexpr (std::same_as<N, std::string>) {
+				if (!ascending_from_zero(string_offsets_, strings_.size())) {
+					return false;
+				}
+			}
+			auto const n = node_count();
+			return std::all_of(targets_.begin(), targets_.end(), [n](node_id v) { return v < n; });
+		}
+
+		// Accessors
+		[[nodiscard]] auto is_node(node_reference value) const -> bool {
+			return id(value).has_value();
+		}
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return header_.node_count == 0;
+		}
+		[[nodiscard]] auto is_connected(node_reference src, node_reference dst) const -> bool {
+			auto const [src_id, dst_id] = checked_ids(src, dst, "is_connected");
+			auto const out = out_edges(src_id);
+			return std::binary_search(out.begin(), out.end(), dst_id);
+		}
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			auto result = std::vector<N>();
+			result.reserve(node_count());
+			for (auto u = node_id{0}; u < node_count(); ++u) {
+				result.emplace_back(node(u));
+			}
+			return result;
+		}
+		[[nodiscard]] auto weights(node_reference src, node_reference dst) const -> std::vector<E> {
+			auto const [src_id, dst_id] = checked_ids(src, dst, "weights");
+			auto const [first, last] = edge_range(src_id, dst_id);
+			return std::vector<E>(weights_.begin() + static_cast<std::ptrdiff_t>(first),
+			                      weights_.begin() + static_cast<std::ptrdiff_t>(last));
+		}
+		// The weights of the edges from src to dst in ascending order, without copying them.
+		[[nodiscard]] auto weights_view(node_reference src, node_reference dst) const
+		   -> std::span<E const> {
+			auto const [src_id, dst_id] = checked_ids(src, dst, "weights_view");
+			auto const [first, last] = edge_range(src_id, dst_id);
+			return weights_.subspan(first, last - first);
+		}
+		[[nodiscard]] auto find(node_reference src, node_reference dst, E const& weight) const
+		   -> iterator {
+			auto const src_id = id(src);
+			auto const dst_id = id(dst);
+			if (!src_id || !dst_id) {
+				return end();
+			}
+			auto const [first, last] = edge_range(*src_id, *dst_id);
+			auto const edge = std::lower_bound(weights_.begin() + static_cast<std::ptrdiff_t>(first),
+			                                   weights_.begin() + static_cast<std::ptrdiff_t>(last),
+			                                   weight);
+			auto const index = static_cast<std::size_t>(edge - weights_.begin());
+			if (index == last || !(*edge == weight)) {
+				return end();
+			}
+			return iterator(this, *src_id, index);
+		}
+		[[nodiscard]] auto connections(node_reference src) const -> std::vector<N> {
+			auto const src_id = id(src);
+			if (!src_id) {
+				throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::connections if src "
+				                         "doesn't exist in the graph");
+			}
+			auto result = std::vector<N>();
+			auto const out = out_edges(*src_id);
+			for (auto it = out.begin(); it != out.end(); it = std::upper_bound(it, out.end(), *it)) {
+				result.emplace_back(node(*it));
+			}
+			return result;
+		}
+
+		// Builds a csr_graph of the snapshot with every edge reversed, for the algorithms that
+		// also walk in-edges.
+		[[nodiscard]] auto transpose() const -> csr_graph<N, E> {
+			return csr_graph<N, E>::transpose_of(*this);
+		}
+
+		// Dense id accessors
+		[[nodiscard]] auto node_count() const noexcept -> node_id {
+			return static_cast<node_id>(header_.node_count);
+		}
+		[[nodiscard]] auto edge_count() const noexcept -> std::size_t {
+			return targets_.size();
+		}
+		[[nodiscard]] auto id(node_reference value) const -> std::optional<node_id> {
+			auto first = node_id{0};
+			auto count = node_count();
+			// lower_bound by hand, as the nodes of a string snapshot aren't stored as one array
+			while (count > 0) {
+				auto const half = count / 2;
+				if (node(first + half) < value) {
+					first += half + 1;
+					count -= half + 1;
+				}
+				else {
+					count = half;
+				}
+			}
+			if (first == node_count() || !(node(first) == value)) {
+				return std::nullopt;
+			}
+			return first;
+		}
+		[[nodiscard]] auto node(node_id u) const noexcept -> node_reference {
+			if constexpr (std::same_as<N, std::string>) {
+				return std::string_view(strings_.data() + string_offsets_[u],
+				                        string_offsets_[u + 1] - string_offsets_[u]);
+			}
+			else {
+				return nodes_[u];
+			}
+		}
+		[[nodiscard]] auto out_degree(node_id u) const noexcept -> std::size_t {
+			return offsets_[u + 1] - offsets_[u];
+		}
+		[[nodiscard]] auto out_edges(node_id u) const noexcept -> std::span<node_id const> {
+			return targets_.subspan(offsets_[u], out_degree(u));
+		}
+		[[nodiscard]] auto out_weights(node_id u) const noexcept -> std::span<E const> {
+			return weights_.subspan(offsets_[u], out_degree(u));
+		}
+		[[nodiscard]] auto offsets() const noexcept -> std::span<std::uint64_t const> {
+			return offsets_;
+		}
+		[[nodiscard]] auto targets() const noexcept -> std::span<node_id const> {
+			return targets_;
+		}
+		[[nodiscard]] auto edge_weights() const noexcept -> std::span<E const> {
+			return weights_;
+		}
+
+	private:
+		static constexpr auto max_nodes = std::uint64_t{0xffffffff};
+
+		[[noreturn]] static auto fail(char const* reason) -> void {
+			throw std::runtime_error(std::string("Cannot load gdwg::mapped_graph<N, E> ") + reason);
+		}
+
+		// count values of T at offset, which must be aligned and lie within the file. The
+		// snapshot was written from objects of type T, and T is trivially copyable, so the
+		// mapped bytes are used as those objects.
+		template<typename T>
+		auto section(std::uint64_t offset, std::uint64_t count) const -> std::span<T const> {
+			auto const bytes = file_.bytes();
+			if (offset % alignof(T) != 0 || offset > bytes.size()
+			    || count > (bytes.size() - offset) / sizeof(T))
+			{
+				fail("from a truncated or damaged snapshot");
+			}
+			if (count == 0) {
+				return {};
+			}
+			return {reinterpret_cast<T const*>(bytes.data() + offset), count};
+		}
+
+		// Whether offsets starts at 0, never decreases and ends at last.
+		static auto ascending_from_zero(std::span<std::uint64_t const> offsets,
+		                                std::uint64_t last) noexcept -> bool {
+			return !offsets.empty() && offsets.front() == 0 && offsets.back() == last
+			       && std::is_sorted(offsets.begin(), offsets.end());
+		}
+
+		auto node_section() const noexcept -> std::span<std::byte const> {
+			if constexpr (std::same_as<N, std::string>) {
+				return std::as_bytes(string_offsets_);
+			}
+			else {
+				return std::as_bytes(nodes_);
+			}
+		}
+
+		auto checked_ids(node_reference src, node_reference dst, char const* function) const
+		   -> std::pair<node_id, node_id> {
+			auto const src_id = id(src);
+			auto const dst_id = id(dst);
+			if (!src_id || !dst_id) {
+				throw std::runtime_error(std::string("Cannot call gdwg::mapped_graph<N, E>::")
+				                         + function + " if src or dst node don't exist in the graph");
+			}
+			return {*src_id, *dst_id};
+		}
+
+		// The [first, last) positions of the edges from src to dst.
+		auto edge_range(node_id src, node_id dst) const -> std::pair<std::size_t, std::size_t> {
+			auto const out = out_edges(src);
+			auto const [first, last] = std::equal_range(out.begin(), out.end(), dst);
+			return {offsets_[src] + static_cast<std::size_t>(first - out.begin()),
+			        offsets_[src] + static_cast<std::size_t>(last - out.begin())};
+		}
+
+		detail::mapped_file file_;
+		detail::snapshot_header header_;
+		std::span<N const> nodes_;
+		std::span<std::uint64_t const> string_offsets_;
+		std::span<char const> strings_;
+		std::span<std::uint64_t const> offsets_;
+		std::span<node_id const> targets_;
+		std::span<E const> weights_;
+	};
+} // namespace gdwg
+
+#endif // GDWG_SNAPSHOT_HPP
@@ -0,0 +1,48 @@
+#ifndef GDWG_STORAGE_HPP
+#define GDWG_STORAGE_HPP
+#include "gdwg/detail/flat_set.hpp"
+
+#include <map>
+#include <set>
+#include <unordered_map>
+
+namespace gdwg {
+	// Storage policies choose the containers behind graph<N, E, Storage>.
+	// A policy provides
+	//     node_map<Key, T>       the node table, a map-like container supporting extract
+	//     set<Key, Compare>      the per-node edge sets, an ordered set-like container
+	//     ordered                whether node_map iterates in key order
+	// Edge sets are always ordered, so connections and weights come out sorted under every
+	// policy. When the node table is unordered, graph iterates nodes in table order and its
+	// iterator is forward only.
+
+	// The default: std::map nodes with std::set edges. Cheap insertion and erasure anywhere.
+	struct ordered_storage {
+		template<typename Key, typename T>
+		using node_map = std::map<Key, T>;
+		template<typename Key, typename Compare>
+		using set = std::set<Key, Compare>;
+		static constexpr bool ordered = true;
+	};
+
+	// Sorted-vector edge sets. Adjacency lists are contiguous, which makes queries and iteration
+	// fast, while inserting or erasing an edge costs O(deg) moves.
+	struct flat_storage {
+		template<typename Key, typename T>
+		using node_map = std::map<Key, T>;
+		template<typename Key, typename Compare>
+		using set = detail::flat_set<Key, Compare>;
+		static constexpr bool ordered = true;
+	};
+
+	// A hashed node table for O(1) node lookup. Requires std::hash<N>.
+	struct hashed_storage {
+		template<typename Key, typename T>
+		using node_map = std::unordered_map<Key, T>;
+		template<typename Key, typename Compare>
+		using set = std::set<Key, Compare>;
+		static constexpr bool ordered = false;
+	};
+} // namespace gdwg
+
+#endif // GDWG_STORAGE_HPP
@@ -0,0 +1,102 @@
+#include "gdwg/algorithm/bfs.hpp"
+#include "gdwg/generators.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+/*
+    Testing Rationale & Approach
+    Distances are unique, so they are compared against a plain queue based search. Parents may
+    legitimately differ between runs, so each parent is instead checked to be a neighbour one
+    step closer to the source. The alpha option forces the search to stay top-down or go
+    bottom-up from the first level, so both directions are checked on their own as well as
+    mixed, on graphs with very different diameters.
+*/
+
+namespace {
+	using csr = gdwg::csr_graph<int, int>;
+
+	auto reference_distances(csr const& g, std::uint32_t source) -> std::vector<std::uint32_t> {
+		auto distance = std::vector<std::uint32_t>(g.node_count(), gdwg::bfs_result::unreached);
+		distance[source] = 0;
+		auto queue = std::deque<std::uint32_t>{source};
+		while (!queue.empty()) {
+			auto const u = queue.front();
+			queue.pop_front();
+			for (auto const v : g.out_edges(u)) {
+				if (distance[v] == gdwg::bfs_result::unreached) {
+					distance[v] = distance[u] + 1;
+					queue.push_back(v);
+				}
+			}
+		}
+		return distance;
+	}
+
+	auto parents_valid(csr const& g, gdwg::bfs_result const& result, std::uint32_t source) -> bool {
+		for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+			auto const parent = result.parent[v];
+			if (v == source || parent == gdwg::bfs_result::unreached) {
+				continue;
+			}
+			if (result.distance[parent] + 1 != result.distance[v]
+			    || !g.is_connected(g.node(parent), g.node(v))) {
+				return false;
+			}
+		}
+		return result.parent[source] == source;
+	}
+
+} // namespace
+
+TEST_CASE("BFS Unit Tests") {
+	SECTION("small graph") {
+		auto g = gdwg::graph<std::string, int>{"A", "B", "C", "D", "E"};
+		g.insert_edge("A", "B", 1);
+		g.insert_edge("A", "B", 2);
+		g.insert_edge("B", "C", 1);
+		g.insert_edge("C", "A", 1);
+		g.insert_edge("D", "A", 1);
+		auto const result = gdwg::bfs(g, std::string("A"));
+		auto constexpr unreached = gdwg::bfs_result::unreached;
+		CHECK(result.distance == std::vector<std::uint32_t>{0, 1, 2, unreached, unreached});
+		CHECK(result.parent == std::vector<std::uint32_t>{0, 0, 1, unreached, unreached});
+		CHECK_THROWS_WITH(gdwg::bfs(g, std::string("F")),
+		                  "Cannot call gdwg::bfs if source doesn't exist in the graph");
+	}
+	SECTION("source without edges") {
+		auto const g = gdwg::graph<int, int>{1, 2};
+		auto const result = gdwg::bfs(g, 2);
+		CHECK(result.distance == std::vector<std::uint32_t>{gdwg::bfs_result::unreached, 0});
+	}
+
+	auto const top_down = gdwg::bfs_options{.threads = 1, .alpha = 1e-18};
+	auto const bottom_up = gdwg::bfs_options{.threads = 1, .alpha = 1e18};
+	auto const parallel = gdwg::bfs_options{.threads = 4};
+	auto const check = [&](csr const& g, std::uint32_t source) {
+		auto const transpose = g.transpose();
+		auto const expected = reference_distances(g, source);
+		for (auto const& options : {gdwg::bfs_options{}, top_down, bottom_up, parallel}) {
+			auto const result = gdwg::bfs(g, transpose, source, options);
+			CHECK(result.distance == expected);
+			CHECK(parents_valid(g, result, source));
+		}
+	};
+	SECTION("power law graph") {
+		check(csr::from_generator(gdwg::rmat_generator(13, 1 << 16, 1)), 0);
+		check(csr::from_generator(gdwg::rmat_generator(13, 1 << 16, 1)), 4000);
+	}
+	SECTION("uniform graph") {
+		check(csr::from_generator(gdwg::erdos_renyi_generator(10000, 40000, 2)), 17);
+	}
+	SECTION("grid") {
+		// a large diameter, so the search switches direction back and forth
+		check(csr::from_generator(gdwg::grid_generator(100, 120, 3)), 0);
+	}
+	SECTION("invalid source") {
+		auto const g = csr::from_generator(gdwg::grid_generator(2, 2, 3));
+		CHECK_THROWS_AS(gdwg::bfs(g, 4), std::runtime_error);
+	}
+}
@@ -0,0 +1,152 @@
+#include "gdwg/algorithm/delta_stepping.hpp"
+#include "gdwg/generators.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+/*
+    Testing Rationale & Approach
+    Delta-stepping must find exactly the distances sequential Dijkstra does, whatever the bucket
+    width and thread count, so it is compared against gdwg::dijkstra across widths from 1, which
+    behaves like Dijkstra, to wider than any path, which behaves like Bellman-Ford, and on
+    weights so much heavier than the bucket width that distances pass the cyclic bucket array
+    and must wait beyond it, without the search ever going back to a bucket it has left. Parents
+    are recovered after the search, so they are checked to follow tight edges back to the source
+    without cycles, including through edges of weight 0.
+*/
+
+namespace {
+	using csr = gdwg::csr_graph<int, std::uint32_t>;
+	using paths = gdwg::shortest_paths<std::uint32_t>;
+
+	template<typename N, typename E>
+	auto parents_valid(gdwg::csr_graph<N, E> const& g,
+	                   gdwg::shortest_paths<E> const& result,
+	                   std::uint32_t source) -> bool {
+		for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+			if (result.parent[v] == paths::unreached) {
+				continue;
+			}
+			// walk to the source, which is no more than node_count() steps away
+			auto steps = std::uint32_t{0};
+			for (auto u = v; u != source; u = result.parent[u], ++steps) {
+				auto const parent = result.parent[u];
+				auto const weights = g.weights(g.node(parent), g.node(u));
+				if (steps > g.node_count() || weights.empty()
+				    || result.distance[parent] + weights.front() != result.distance[u])
+				{
+					return false;
+				}
+			}
+		}
+		return result.parent[source] == source;
+	}
+
+	auto check(csr const& g, std::uint32_t source) -> void {
+		auto const expected = gdwg::dijkstra(g, source).distance;
+		for (auto const delta : {0U, 1U, 50U, 400U, 1U << 30}) {
+			for (auto const threads : {1U, 4U}) {
+				auto const result = gdwg::delta_stepping(g, source, {delta, threads});
+				CHECK(result.distance == expected);
+				CHECK(parents_valid(g, result, source));
+			}
+		}
+	}
+} // namespace
+
+TEST_CASE("Delta-Stepping Unit Tests") {
+	SECTION("small graph") {
+		auto g = gdwg::graph<std::string, int>{"A", "B", "C", "D"};
+		g.insert_edge("A", "B", 7);
+		g.insert_edge("A", "B", 2);
+		g.insert_edge("A", "C", 9);
+		g.insert_edge("B", "C", 3);
+		auto const result = gdwg::delta_stepping(g, std::string("A"), {.delta = 2});
+		auto constexpr infinity = gdwg::shortest_paths<int>::infinity;
+		auto constexpr unreached = gdwg::shortest_paths<int>::unreached;
+		CHECK(result.distance == std::vector<int>{0, 2, 5, infinity});
+		CHECK(result.parent == std::vector<std::uint32_t>{0, 0, 1, unreached});
+		CHECK_THROWS_WITH(gdwg::delta_stepping(g, std::string("E")),
+		                  "Cannot call gdwg::delta_stepping if source doesn't exist in the graph");
+		CHECK_THROWS_WITH(gdwg::delta_stepping(g, std::string("A"), {.delta = -1}),
+		                  "Cannot call gdwg::delta_stepping with a negative delta");
+		g.insert_edge("C", "D", -4);
+		CHECK_THROWS_WITH(gdwg::delta_stepping(g, std::string("A")),
+		                  "Cannot call gdwg::delta_stepping on a graph with negative edge weights");
+	}
+	SECTION("weight 0 cycles") {
+		auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5};
+		g.insert_edge(1, 2, 5);
+		g.insert_edge(2, 3, 0);
+		g.insert_edge(3, 4, 0);
+		g.insert_edge(4, 2, 0);
+		g.insert_edge(4, 3, 0);
+		g.insert_edge(3, 5, 0);
+		g.insert_edge(1, 5, 5);
+		auto const snapshot = gdwg::csr_graph(g);
+		for (auto const threads : {1U, 4U}) {
+			auto const result = gdwg::delta_stepping(snapshot, 0, {.threads = threads});
+			CHECK(result.distance == std::vector<int>{0, 5, 5, 5, 5});
+			CHECK(parents_valid(snapshot, result, 0));
+		}
+	}
+	SECTION("floating point weights") {
+		auto g = gdwg::graph<char, double>{'a', 'b', 'c'};
+		g.insert_edge('a', 'b', 0.5);
+		g.insert_edge('b', 'c', 0.25);
+		g.insert_edge('a', 'c', 1.0);
+		CHECK(gdwg::delta_stepping(g, 'a', {.delta = 0.1}).distance
+		      == std::vector<double>{0, 0.5, 0.75});
+	}
+	SECTION("weights far heavier than delta") {
+		auto g = gdwg::graph<int, std::uint32_t>{0, 1, 2};
+		g.insert_edge(0, 1, 1000000000);
+		g.insert_edge(1, 2, 1);
+		auto g2 = gdwg::graph<int, double>{0, 1, 2};
+		g2.insert_edge(0, 1, 1e12);
+		g2.insert_edge(1, 2, 0.5);
+		g2.insert_edge(0, 2, 2e12);
+		for (auto const threads : {1U, 4U}) {
+			CHECK(gdwg::delta_stepping(g, 0, {.delta = 1, .threads = threads}).distance
+			      == std::vector<std::uint32_t>{0, 1000000000, 1000000001});
+			CHECK(gdwg::delta_stepping(g2, 0, {.delta = 1e-9, .threads = threads}).distance
+			      == std::vector<double>{0, 1e12, 1e12 + 0.5});
+		}
+		check(csr::from_generator(gdwg::erdos_renyi_generator(1000, 4000, 3, 100000000)), 5);
+	}
+	SECTION("paths too heavy for the weight type") {
+		constexpr auto max = std::numeric_limits<int>::max();
+		auto g = gdwg::graph<int, int>{1, 2, 3, 4};
+		g.insert_edge(1, 2, max - 10);
+		g.insert_edge(2, 3, 100);
+		g.insert_edge(2, 4, 9);
+		for (auto const threads : {1U, 4U}) {
+			CHECK(gdwg::delta_stepping(g, 1, {.threads = threads}).distance
+			      == std::vector<int>{0, max - 10, gdwg::shortest_paths<int>::infinity, max - 1});
+		}
+	}
+	SECTION("distances past the bucket array wait without revisiting buckets") {
+		// weights up to 100000 over a delta of 10 need far more buckets than the array holds
+		auto const g = csr::from_generator(gdwg::erdos_renyi_generator(2000, 10000, 4, 100000));
+		auto const expected = gdwg::dijkstra(g, 0).distance;
+		for (auto const threads : {1U, 4U}) {
+			auto stats = gdwg::delta_stepping_stats();
+			auto const result =
+			   gdwg::delta_stepping(g, 0, {.delta = 10, .threads = threads, .stats = &stats});
+			CHECK(result.distance == expected);
+			CHECK(stats.buckets > 1024);
+			CHECK(stats.revisited == 0);
+		}
+	}
+	SECTION("power law graph") {
+		check(csr::from_generator(gdwg::rmat_generator(12, 1 << 15, 1)), 0);
+	}
+	SECTION("uniform graph") {
+		check(csr::from_generator(gdwg::erdos_renyi_generator(5000, 20000, 2)), 17);
+	}
+	SECTION("grid") {
+		check(csr::from_generator(gdwg::grid_generator(60, 70, 3)), 1234);
+	}
+}
@@ -0,0 +1,158 @@
+#include "gdwg/algorithm/dijkstra.hpp"
+#include "gdwg/generators.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+/*
+    Testing Rationale & Approach
+    Every queue must give the same distances, so each is compared against Bellman-Ford, which
+    shares no code with them, on generated graphs that contain parallel edges of different
+    weights. Parents are checked to lie on a shortest path rather than compared, since ties may
+    be broken differently. A reused search is compared against a fresh one for each query, and
+    early termination is checked to settle the target with the same distance as a full run.
+*/
+
+namespace {
+	using csr = gdwg::csr_graph<int, std::uint32_t>;
+	using paths = gdwg::shortest_paths<std::uint32_t>;
+
+	auto bellman_ford(csr const& g, std::uint32_t source) -> std::vector<std::uint32_t> {
+		auto distance = std::vector<std::uint32_t>(g.node_count(), paths::infinity);
+		distance[source] = 0;
+		for (auto changed = true; changed;) {
+			changed = false;
+			for (auto u = std::uint32_t{0}; u < g.node_count(); ++u) {
+				if (distance[u] == paths::infinity) {
+					continue;
+				}
+				auto const targets = g.out_edges(u);
+				auto const weights = g.out_weights(u);
+				for (auto i = std::size_t{0}; i < targets.size(); ++i) {
+					if (distance[u] + weights[i] < distance[targets[i]]) {
+						distance[targets[i]] = distance[u] + weights[i];
+						changed = true;
+					}
+				}
+			}
+		}
+		return distance;
+	}
+
+	auto parents_valid(csr const& g, paths const& result, std::uint32_t source) -> bool {
+		for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+			auto const parent = result.parent[v];
+			if (v == source || parent == paths::unreached) {
+				continue;
+			}
+			auto const weights = g.weights(g.node(parent), g.node(v));
+			if (weights.empty() || result.distance[parent] + weights.front() != result.distance[v]) {
+				return false;
+			}
+		}
+		return result.parent[source] == source;
+	}
+
+	template<template<typename, typename> typename Queue>
+	auto check(csr const& g, std::uint32_t source) -> void {
+		auto const result = gdwg::dijkstra<Queue>(g, source);
+		CHECK(result.distance == bellman_ford(g, source));
+		CHECK(parents_valid(g, result, source));
+	}
+} // namespace
+
+TEST_CASE("Dijkstra Unit Tests") {
+	SECTION("small graph") {
+		auto g = gdwg::graph<std::string, int>{"A", "B", "C", "D", "E"};
+		g.insert_edge("A", "B", 7);
+		g.insert_edge("A", "B", 2);
+		g.insert_edge("A", "C", 9);
+		g.insert_edge("B", "C", 3);
+		g.insert_edge("C", "A", 0);
+		g.insert_edge("E", "A", 1);
+		auto const result = gdwg::dijkstra(g, std::string("A"));
+		auto constexpr infinity = gdwg::shortest_paths<int>::infinity;
+		auto constexpr unreached = gdwg::shortest_paths<int>::unreached;
+		CHECK(result.distance == std::vector<int>{0, 2, 5, infinity, infinity});
+		CHECK(result.parent == std::vector<std::uint32_t>{0, 0, 1, unreached, unreached});
+
+		CHECK(gdwg::shortest_path(g, std::string("A"), std::string("C"))
+		      == std::pair{5, std::vector<std::string>{"A", "B", "C"}});
+		CHECK(gdwg::shortest_path(g, std::string("A"), std::string("A"))
+		      == std::pair{0, std::vector<std::string>{"A"}});
+		CHECK(gdwg::shortest_path(g, std::string("A"), std::string("E")) == std::nullopt);
+		CHECK_THROWS_WITH(gdwg::dijkstra(g, std::string("F")),
+		                  "Cannot call gdwg::dijkstra if source or target doesn't exist in the "
+		                  "graph");
+		CHECK_THROWS_WITH(gdwg::shortest_path(g, std::string("A"), std::string("F")),
+		                  "Cannot call gdwg::dijkstra if source or target doesn't exist in the "
+		                  "graph");
+	}
+	SECTION("negative weights") {
+		auto g = gdwg::graph<int, int>{1, 2, 3};
+		g.insert_edge(1, 2, 4);
+		g.insert_edge(2, 3, 5);
+		g.insert_edge(2, 3, -1);
+		CHECK_THROWS_WITH(gdwg::dijkstra(g, 1),
+		                  "Cannot call gdwg::dijkstra on a graph with negative edge weights");
+		// not reachable, so never relaxed
+		CHECK_NOTHROW(gdwg::dijkstra(g, 3));
+	}
+	SECTION("paths too heavy for the weight type") {
+		constexpr auto max = std::numeric_limits<int>::max();
+		auto g = gdwg::graph<int, int>{1, 2, 3, 4};
+		g.insert_edge(1, 2, max - 10);
+		g.insert_edge(2, 3, 100);
+		g.insert_edge(2, 4, 9);
+		auto const infinity = gdwg::shortest_paths<int>::infinity;
+		CHECK(gdwg::dijkstra(g, 1).distance == std::vector<int>{0, max - 10, infinity, max - 1});
+		CHECK(gdwg::dijkstra<gdwg::radix_heap>(g, 1).parent[2]
+		      == gdwg::shortest_paths<int>::unreached);
+		auto small = gdwg::graph<int, std::uint8_t>{1, 2, 3};
+		small.insert_edge(1, 2, 200);
+		small.insert_edge(2, 3, 100);
+		CHECK(gdwg::dijkstra(small, 1).distance == std::vector<std::uint8_t>{0, 200, 255});
+	}
+	SECTION("floating point weights") {
+		auto g = gdwg::graph<char, double>{'a', 'b', 'c'};
+		g.insert_edge('a', 'b', 0.5);
+		g.insert_edge('b', 'c', 0.25);
+		g.insert_edge('a', 'c', 1.0);
+		CHECK(gdwg::dijkstra<gdwg::quaternary_heap>(g, 'a').distance
+		      == std::vector<double>{0, 0.5, 0.75});
+	}
+	SECTION("every queue") {
+		auto const power_law = csr::from_generator(gdwg::rmat_generator(11, 1 << 14, 1));
+		auto const grid = csr::from_generator(gdwg::grid_generator(40, 50, 2));
+		for (auto const source : {0U, 1000U}) {
+			check<gdwg::binary_heap>(power_law, source);
+			check<gdwg::quaternary_heap>(power_law, source);
+			check<gdwg::radix_heap>(power_law, source);
+			check<gdwg::binary_heap>(grid, source);
+			check<gdwg::quaternary_heap>(grid, source);
+			check<gdwg::radix_heap>(grid, source);
+		}
+	}
+	SECTION("reused search") {
+		auto const g = csr::from_generator(gdwg::erdos_renyi_generator(3000, 9000, 3));
+		auto search = gdwg::dijkstra_search<int, std::uint32_t, gdwg::radix_heap>(g);
+		for (auto source = std::uint32_t{0}; source < 3000; source += 250) {
+			search.run(source);
+			CHECK(search.result().distance == gdwg::dijkstra(g, source).distance);
+
+			auto const target = (source * 7 + 11) % 3000;
+			auto const full = gdwg::dijkstra(g, source);
+			CHECK(search.run(source, target) == (full.parent[target] != paths::unreached));
+			CHECK(search.distance(target) == full.distance[target]);
+			auto const path = search.path(target);
+			if (!path.empty()) {
+				CHECK(path.front() == source);
+				CHECK(path.back() == target);
+			}
+		}
+		CHECK_THROWS_AS(search.run(0, 3000), std::runtime_error);
+	}
+}
@@ -0,0 +1,81 @@
+#include "gdwg/algorithm/heap.hpp"
+#include "gdwg/generators.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+/*
+    Testing Rationale & Approach
+    Each queue is driven the way Dijkstra drives it: pops interleaved with pushes of keys no
+    smaller than the last key popped, which is all radix_heap promises to handle. The keys
+    popped must come out in order and match the multiset pushed. Queues are cleared and reused
+    to check that no state survives clear().
+*/
+
+namespace {
+	template<typename Queue>
+	auto check_monotone(Queue& queue, std::uint64_t seed) -> void {
+		auto pushed = std::vector<std::pair<std::uint32_t, std::uint32_t>>();
+		auto popped = std::vector<std::pair<std::uint32_t, std::uint32_t>>();
+		auto last = std::uint32_t{0};
+		for (auto step = std::uint64_t{0}; step < 5000; ++step) {
+			auto const bits = gdwg::detail::random_bits(seed, step, 0);
+			if (bits % 3 != 0 || queue.empty()) {
+				auto const key = last + static_cast<std::uint32_t>(bits % 1000);
+				pushed.emplace_back(key, static_cast<std::uint32_t>(step));
+				queue.push(key, static_cast<std::uint32_t>(step));
+			}
+			else {
+				popped.push_back(queue.pop());
+				CHECK(popped.back().first >= last);
+				last = popped.back().first;
+			}
+		}
+		while (!queue.empty()) {
+			popped.push_back(queue.pop());
+			CHECK(popped.back().first >= last);
+			last = popped.back().first;
+		}
+		std::sort(pushed.begin(), pushed.end());
+		std::sort(popped.begin(), popped.end());
+		CHECK(popped == pushed);
+	}
+} // namespace
+
+TEST_CASE("Heap Unit Tests") {
+	SECTION("binary heap") {
+		auto queue = gdwg::binary_heap<std::uint32_t, std::uint32_t>();
+		check_monotone(queue, 1);
+		check_monotone(queue, 2);
+	}
+	SECTION("quaternary heap") {
+		auto queue = gdwg::quaternary_heap<std::uint32_t, std::uint32_t>();
+		check_monotone(queue, 1);
+		queue.push(5, 0);
+		queue.clear();
+		CHECK(queue.empty());
+		check_monotone(queue, 2);
+	}
+	SECTION("radix heap") {
+		auto queue = gdwg::radix_heap<std::uint32_t, std::uint32_t>();
+		check_monotone(queue, 1);
+		queue.push(1U << 30, 0);
+		CHECK(queue.size() == 1);
+		queue.clear();
+		// clear() forgets the last key popped, so small keys are accepted again
+		check_monotone(queue, 2);
+	}
+	SECTION("d-ary heap with arbitrary keys") {
+		auto queue = gdwg::d_ary_heap<double, char, 3>();
+		for (auto const key : {2.5, -1.0, 7.0, 0.0, 2.5}) {
+			queue.push(key, 'x');
+		}
+		auto keys = std::vector<double>();
+		while (!queue.empty()) {
+			keys.push_back(queue.pop().first);
+		}
+		CHECK(keys == std::vector<double>{-1.0, 0.0, 2.5, 2.5, 7.0});
+	}
+}
@@ -0,0 +1,79 @@
+#include "gdwg/detail/parallel.hpp"
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <vector>
+/*
+    Testing Rationale & Approach
+    The algorithms only reach parallel_for, parallel_expand and parallel_rounds through their own
+    bodies, and an allocation failure can't be forced from there, so the helpers are driven
+    directly. A body that throws on one chunk must surface its exception on the calling thread,
+    whichever thread ran the chunk, instead of terminating, and the chunks after it must stop
+    being handed out. A round that throws must likewise end the rounds and be rethrown.
+*/
+
+TEST_CASE("Parallel Helper Unit Tests") {
+	SECTION("parallel_for visits every item once") {
+		for (auto const threads : {1U, 4U}) {
+			auto seen = std::vector<std::atomic<int>>(10000);
+			gdwg::detail::parallel_for(seen.size(), threads, 64, [&](unsigned, auto first, auto last) {
+				for (auto i = first; i < last; ++i) {
+					++seen[i];
+				}
+			});
+			for (auto const& count : seen) {
+				CHECK(count == 1);
+			}
+		}
+	}
+	SECTION("parallel_for rethrows the exception of a body") {
+		for (auto const threads : {1U, 4U}) {
+			auto chunks = std::atomic<std::size_t>{0};
+			auto const body = [&](unsigned, std::size_t first, std::size_t) {
+				++chunks;
+				if (first == 640) {
+					throw std::runtime_error("chunk 10");
+				}
+			};
+			CHECK_THROWS_WITH(gdwg::detail::parallel_for(100000, threads, 64, body), "chunk 10");
+			// chunks already claimed finish, but no new chunks are claimed after the throw
+			CHECK(chunks < 100000 / 64);
+		}
+	}
+	SECTION("parallel_expand rethrows bad_alloc from a body") {
+		auto frontier = std::vector<int>(50000);
+		for (auto i = 0; i < 50000; ++i) {
+			frontier[static_cast<std::size_t>(i)] = i;
+		}
+		auto const body = [](int item, std::vector<int>& next) {
+			if (item == 30000) {
+				throw std::bad_alloc();
+			}
+			next.push_back(item);
+		};
+		CHECK_THROWS_AS(gdwg::detail::parallel_expand(frontier, 4, 256, body), std::bad_alloc);
+		auto const next = gdwg::detail::parallel_expand(frontier, 4, 256, [](int item, auto& out) {
+			out.push_back(item);
+		});
+		CHECK(next.size() == frontier.size());
+	}
+	SECTION("parallel_rounds rethrows the exception of a round") {
+		for (auto const threads : {1U, 4U}) {
+			auto rounds = 0;
+			auto const round = [&](unsigned thread) {
+				if (rounds == 3 && thread == threads - 1) {
+					throw std::bad_alloc();
+				}
+			};
+			auto const between = [&] {
+				++rounds;
+				return true;
+			};
+			CHECK_THROWS_AS(gdwg::detail::parallel_rounds(threads, round, between), std::bad_alloc);
+			CHECK(rounds == 3);
+		}
+	}
+}
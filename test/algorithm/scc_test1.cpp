@@ -0,0 +1,147 @@
+#include "gdwg/algorithm/scc.hpp"
+#include "gdwg/generators.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+/*
+    Testing Rationale & Approach
+    On small graphs both algorithms are checked against the definition: two nodes share a
+    component exactly when each reaches the other, found by a search from every node. On larger
+    generated graphs the parallel algorithm must give the same partition as Tarjan's, and
+    Tarjan's labels must follow the condensation's reverse topological order. A cycle of a
+    million nodes checks that Tarjan's search does not recurse.
+*/
+
+namespace {
+	using csr = gdwg::csr_graph<int, std::uint32_t>;
+
+	auto reachable(csr const& g, std::uint32_t source) -> std::vector<bool> {
+		auto seen = std::vector<bool>(g.node_count());
+		auto stack = std::vector<std::uint32_t>{source};
+		seen[source] = true;
+		while (!stack.empty()) {
+			auto const u = stack.back();
+			stack.pop_back();
+			for (auto const v : g.out_edges(u)) {
+				if (!seen[v]) {
+					seen[v] = true;
+					stack.push_back(v);
+				}
+			}
+		}
+		return seen;
+	}
+
+	// Whether labels partition the nodes exactly as mutual reachability does.
+	auto matches_definition(csr const& g, gdwg::components const& result) -> bool {
+		auto reach = std::vector<std::vector<bool>>();
+		for (auto u = std::uint32_t{0}; u < g.node_count(); ++u) {
+			reach.push_back(reachable(g, u));
+		}
+		for (auto u = std::uint32_t{0}; u < g.node_count(); ++u) {
+			for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+				auto const same = result.component[u] == result.component[v];
+				if (same != (reach[u][v] && reach[v][u]) || result.component[u] >= result.count) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// Relabels by first appearance, so equal partitions compare equal.
+	auto canonical(gdwg::components const& result) -> std::vector<std::uint32_t> {
+		auto renumber = std::vector<std::uint32_t>(result.count, gdwg::components::unassigned);
+		auto next = std::uint32_t{0};
+		auto labels = result.component;
+		for (auto& label : labels) {
+			if (renumber[label] == gdwg::components::unassigned) {
+				renumber[label] = next++;
+			}
+			label = renumber[label];
+		}
+		return labels;
+	}
+
+	auto reverse_topological(csr const& g, gdwg::components const& result) -> bool {
+		for (auto const& [from, to, weight] : g) {
+			if (result.component[static_cast<std::uint32_t>(from)]
+			    < result.component[static_cast<std::uint32_t>(to)])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	auto check(csr const& g) -> void {
+		auto const tarjan = gdwg::tarjan_scc(g);
+		CHECK(reverse_topological(g, tarjan));
+		for (auto const threads : {1U, 4U}) {
+			auto const parallel = gdwg::parallel_scc(g, {threads});
+			CHECK(parallel.count == tarjan.count);
+			CHECK(canonical(parallel) == canonical(tarjan));
+			// already labelled by lowest node
+			CHECK(canonical(parallel) == parallel.component);
+		}
+	}
+} // namespace
+
+TEST_CASE("SCC Unit Tests") {
+	SECTION("graph overload") {
+		auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+		g.insert_edge("a", "b", 1);
+		g.insert_edge("b", "a", 1);
+		g.insert_edge("b", "c", 1);
+		g.insert_edge("c", "d", 1);
+		g.insert_edge("d", "c", 1);
+		g.insert_edge("e", "e", 1);
+		auto const result = gdwg::strongly_connected_components(g);
+		CHECK(result.count == 3);
+		// {c, d} completes first as nothing leaves it
+		CHECK(result.component == std::vector<std::uint32_t>{1, 1, 0, 0, 2});
+		CHECK(gdwg::strongly_connected_components(g, {2}).component
+		      == std::vector<std::uint32_t>{0, 0, 1, 1, 2});
+	}
+	SECTION("empty graph") {
+		auto const g = csr();
+		CHECK(gdwg::tarjan_scc(g).count == 0);
+		CHECK(gdwg::parallel_scc(g).count == 0);
+	}
+	SECTION("small generated graphs") {
+		for (auto seed = std::uint64_t{0}; seed < 20; ++seed) {
+			auto const g = csr::from_generator(gdwg::erdos_renyi_generator(60, 30 + seed * 6, seed));
+			CHECK(matches_definition(g, gdwg::tarjan_scc(g)));
+			CHECK(matches_definition(g, gdwg::parallel_scc(g, {4})));
+		}
+	}
+	SECTION("large generated graphs") {
+		check(csr::from_generator(gdwg::rmat_generator(14, 1 << 16, 1)));
+		check(csr::from_generator(gdwg::erdos_renyi_generator(20000, 22000, 2)));
+		check(csr::from_generator(gdwg::grid_generator(50, 60, 3)));
+	}
+	SECTION("long cycle and chain") {
+		auto constexpr n = 1'000'000;
+		auto nodes = std::vector<int>();
+		auto edges = std::vector<std::tuple<int, int, int>>();
+		for (auto i = 0; i < n; ++i) {
+			nodes.push_back(i);
+			edges.emplace_back(i, i + 1 < n ? i + 1 : 0, 0);
+		}
+		auto const cycle = gdwg::csr_graph<int, int>(nodes, edges.begin(), edges.end());
+		CHECK(gdwg::tarjan_scc(cycle).count == 1);
+		CHECK(gdwg::parallel_scc(cycle, {4}).count == 1);
+
+		// edges against id order, the worst case for colouring
+		edges.pop_back();
+		for (auto& [from, to, weight] : edges) {
+			std::swap(from, to);
+		}
+		auto const chain = gdwg::csr_graph<int, int>(nodes, edges.begin(), edges.end());
+		CHECK(gdwg::tarjan_scc(chain).count == n);
+		CHECK(gdwg::parallel_scc(chain, {4}).count == n);
+	}
+}
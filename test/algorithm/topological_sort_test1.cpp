@@ -0,0 +1,193 @@
+#include "gdwg/algorithm/topological_sort.hpp"
+#include "gdwg/generators.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+/*
+    Testing Rationale & Approach
+    A topological order is checked against its definition: every node placed exactly once and
+    after all of its in-neighbours, with each level one more than the highest level among them.
+    Generated graphs are made acyclic by pointing every edge from the lower id to the higher, and
+    the order must be the same for any number of threads. With a cycle, the placed nodes must be
+    exactly those no cycle reaches, and find_cycle must return a real cycle made of graph edges.
+    Chains of a million nodes check that neither search recurses.
+*/
+
+namespace {
+	using csr = gdwg::csr_graph<int, std::uint32_t>;
+
+	auto nodes(std::uint64_t n) -> std::vector<int> {
+		auto result = std::vector<int>();
+		for (auto i = std::uint64_t{0}; i < n; ++i) {
+			result.push_back(static_cast<int>(i));
+		}
+		return result;
+	}
+
+	// The generated graph with every edge pointing from its lower id to its higher, and no loops.
+	template<typename Generator>
+	auto dag(Generator const& generator) -> csr {
+		auto edges = std::vector<gdwg::generated_edge>();
+		for (auto edge : generator) {
+			if (edge.src > edge.dst) {
+				std::swap(edge.src, edge.dst);
+			}
+			if (edge.src != edge.dst) {
+				edges.push_back(edge);
+			}
+		}
+		return csr(nodes(generator.node_count()), edges.begin(), edges.end());
+	}
+
+	auto is_topological(csr const& g, gdwg::topological_order const& result) -> bool {
+		auto const n = g.node_count();
+		if (result.order.size() != n || result.level.size() != n || !result.acyclic()) {
+			return false;
+		}
+		auto position = std::vector<std::size_t>(n, n);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			if (position[result.order[i]] != n) {
+				return false;
+			}
+			position[result.order[i]] = i;
+		}
+		// the longest path ending at each node, relaxed in the order given
+		auto longest = std::vector<std::uint32_t>(n);
+		for (auto const u : result.order) {
+			for (auto const v : g.out_edges(u)) {
+				if (position[u] >= position[v]) {
+					return false;
+				}
+				longest[v] = std::max(longest[v], longest[u] + 1);
+			}
+		}
+		return longest == result.level;
+	}
+
+	auto is_cycle(csr const& g, std::vector<std::uint32_t> const& cycle) -> bool {
+		if (cycle.empty()) {
+			return false;
+		}
+		for (auto i = std::size_t{0}; i < cycle.size(); ++i) {
+			auto const next = cycle[(i + 1) % cycle.size()];
+			if (!g.is_connected(g.node(cycle[i]), g.node(next))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Whether exactly the nodes that no cycle reaches are placed. A node must be placed exactly
+	// when all of its in-neighbours are, one level above the highest of them; levels that
+	// consistent cannot run around a cycle, so no cycle is placed either.
+	auto places_exactly_acyclic_part(csr const& g, gdwg::topological_order const& result) -> bool {
+		constexpr auto unplaced = gdwg::topological_order::unplaced;
+		auto const transpose = g.transpose();
+		for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+			auto level = std::uint32_t{0};
+			for (auto const u : transpose.out_edges(v)) {
+				level = result.level[u] == unplaced ? unplaced : std::max(level, result.level[u] + 1);
+				if (level == unplaced) {
+					break;
+				}
+			}
+			if (result.level[v] != level) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	auto check_dag(csr const& g) -> void {
+		auto const sequential = gdwg::topological_sort(g, {1});
+		CHECK(is_topological(g, sequential));
+		auto const parallel = gdwg::topological_sort(g, {4});
+		CHECK(parallel.order == sequential.order);
+		CHECK(parallel.level_count == sequential.level_count);
+		CHECK(!gdwg::find_cycle(g).has_value());
+		CHECK(gdwg::is_dag(g));
+	}
+
+	auto check_cyclic(csr const& g) -> void {
+		auto const result = gdwg::topological_sort(g, {4});
+		CHECK(!result.acyclic());
+		CHECK(places_exactly_acyclic_part(g, result));
+		auto const cycle = gdwg::find_cycle(g);
+		REQUIRE(cycle.has_value());
+		CHECK(is_cycle(g, *cycle));
+		CHECK(!gdwg::is_dag(g));
+	}
+} // namespace
+
+TEST_CASE("Topological Sort Unit Tests") {
+	SECTION("graph overload") {
+		auto g = gdwg::graph<std::string, int>{"compile", "link", "test", "fetch", "docs"};
+		g.insert_edge("fetch", "compile", 1);
+		g.insert_edge("compile", "link", 1);
+		g.insert_edge("link", "test", 1);
+		g.insert_edge("fetch", "docs", 1);
+		auto const result = gdwg::topological_sort(g);
+		// nodes() is {compile, docs, fetch, link, test}
+		CHECK(result.order == std::vector<std::uint32_t>{2, 0, 1, 3, 4});
+		CHECK(result.level == std::vector<std::uint32_t>{1, 1, 0, 2, 3});
+		CHECK(result.level_count == 4);
+		CHECK(gdwg::is_dag(g));
+		CHECK(gdwg::find_cycle(g) == std::nullopt);
+
+		g.insert_edge("test", "compile", 1);
+		CHECK(!gdwg::topological_sort(g).acyclic());
+		CHECK(!gdwg::is_dag(g));
+		CHECK(gdwg::find_cycle(g) == std::vector<std::string>{"compile", "link", "test"});
+	}
+	SECTION("self-loop") {
+		auto g = gdwg::graph<int, int>{1, 2};
+		g.insert_edge(1, 2, 0);
+		g.insert_edge(2, 2, 0);
+		CHECK(gdwg::find_cycle(g) == std::vector<int>{2});
+		auto const result = gdwg::topological_sort(g);
+		CHECK(result.order == std::vector<std::uint32_t>{0});
+		CHECK(result.level[1] == gdwg::topological_order::unplaced);
+	}
+	SECTION("empty graph") {
+		auto const g = csr();
+		auto const result = gdwg::topological_sort(g);
+		CHECK(result.order.empty());
+		CHECK(result.level_count == 0);
+		CHECK(result.acyclic());
+		CHECK(gdwg::is_dag(g));
+	}
+	SECTION("generated acyclic graphs") {
+		check_dag(dag(gdwg::rmat_generator(14, 1 << 16, 1)));
+		check_dag(dag(gdwg::erdos_renyi_generator(20000, 60000, 2)));
+		check_dag(dag(gdwg::grid_generator(50, 60, 3)));
+	}
+	SECTION("generated cyclic graphs") {
+		for (auto seed = std::uint64_t{0}; seed < 10; ++seed) {
+			check_cyclic(csr::from_generator(gdwg::erdos_renyi_generator(2000, 4000, seed)));
+		}
+		check_cyclic(csr::from_generator(gdwg::rmat_generator(14, 1 << 16, 1)));
+		check_cyclic(csr::from_generator(gdwg::grid_generator(50, 60, 3)));
+	}
+	SECTION("long chain and cycle") {
+		auto constexpr n = 1'000'000;
+		auto edges = std::vector<std::tuple<int, int, int>>();
+		for (auto i = 0; i + 1 < n; ++i) {
+			edges.emplace_back(i, i + 1, 0);
+		}
+		auto const chain = gdwg::csr_graph<int, int>(nodes(n), edges.begin(), edges.end());
+		auto const result = gdwg::topological_sort(chain, {4});
+		CHECK(result.acyclic());
+		CHECK(result.level_count == n);
+		CHECK(gdwg::is_dag(chain));
+
+		edges.emplace_back(n - 1, 0, 0);
+		auto const cycle = gdwg::csr_graph<int, int>(nodes(n), edges.begin(), edges.end());
+		CHECK(gdwg::topological_sort(cycle, {4}).order.empty());
+		CHECK(gdwg::find_cycle(cycle)->size() == n);
+	}
+}
@@ -0,0 +1,136 @@
+#include "gdwg/algorithm/wcc.hpp"
+#include "gdwg/generators.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+/*
+    Testing Rationale & Approach
+    Components are checked against an undirected search from every unlabelled node, which also
+    fixes the expected labelling by lowest node. Generated graphs are sparse enough to split
+    into many components, and are run with no neighbour rounds, the default, and more rounds
+    than any node has edges, so that both the sampled and the skipped paths are exercised.
+    incremental_components is checked against the batch result after every insertion.
+*/
+
+namespace {
+	using csr = gdwg::csr_graph<int, std::uint32_t>;
+
+	auto reference(csr const& g) -> gdwg::components {
+		auto const transpose = g.transpose();
+		auto result = gdwg::components{0, std::vector<std::uint32_t>(g.node_count(),
+		                                                             gdwg::components::unassigned)};
+		for (auto root = std::uint32_t{0}; root < g.node_count(); ++root) {
+			if (result.component[root] != gdwg::components::unassigned) {
+				continue;
+			}
+			auto stack = std::vector<std::uint32_t>{root};
+			result.component[root] = result.count;
+			while (!stack.empty()) {
+				auto const u = stack.back();
+				stack.pop_back();
+				for (auto const* side : {&g, &transpose}) {
+					for (auto const v : side->out_edges(u)) {
+						if (result.component[v] == gdwg::components::unassigned) {
+							result.component[v] = result.count;
+							stack.push_back(v);
+						}
+					}
+				}
+			}
+			++result.count;
+		}
+		return result;
+	}
+
+	auto check(csr const& g) -> void {
+		auto const expected = reference(g);
+		for (auto const rounds : {0U, 2U, 100U}) {
+			for (auto const threads : {1U, 4U}) {
+				auto const result = gdwg::weakly_connected_components(g, {threads, rounds});
+				CHECK(result.count == expected.count);
+				CHECK(result.component == expected.component);
+			}
+		}
+	}
+} // namespace
+
+TEST_CASE("WCC Unit Tests") {
+	SECTION("graph overload") {
+		auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+		g.insert_edge("a", "d", 1);
+		g.insert_edge("e", "d", 1);
+		g.insert_edge("c", "c", 1);
+		auto const result = gdwg::weakly_connected_components(g);
+		CHECK(result.count == 3);
+		CHECK(result.component == std::vector<std::uint32_t>{0, 1, 2, 0, 0});
+	}
+	SECTION("empty graph") {
+		CHECK(gdwg::weakly_connected_components(csr()).count == 0);
+	}
+	SECTION("generated graphs") {
+		check(csr::from_generator(gdwg::erdos_renyi_generator(20000, 9000, 1)));
+		check(csr::from_generator(gdwg::erdos_renyi_generator(20000, 20000, 2)));
+		check(csr::from_generator(gdwg::rmat_generator(14, 1 << 13, 3)));
+		check(csr::from_generator(gdwg::grid_generator(30, 40, 4)));
+	}
+}
+
+TEST_CASE("Incremental Components Unit Tests") {
+	SECTION("insertions") {
+		auto c = gdwg::incremental_components<std::string>();
+		CHECK(c.insert_node("a"));
+		CHECK(c.insert_node("b"));
+		CHECK(c.insert_node("c"));
+		CHECK_FALSE(c.insert_node("a"));
+		CHECK(c.component_count() == 3);
+		CHECK_FALSE(c.connected("a", "b"));
+		CHECK(c.insert_edge("b", "a"));
+		CHECK_FALSE(c.insert_edge("a", "b"));
+		CHECK(c.connected("a", "b"));
+		CHECK_FALSE(c.connected("a", "c"));
+		CHECK(c.component_count() == 2);
+		CHECK(c.component_size("b") == 2);
+		CHECK(c.is_node("c"));
+		CHECK_FALSE(c.is_node("d"));
+		CHECK_THROWS_WITH(c.insert_edge("a", "d"),
+		                  "Cannot call gdwg::incremental_components<N>::insert_edge on a node that "
+		                  "doesn't exist");
+		CHECK_THROWS_WITH(c.connected("d", "a"),
+		                  "Cannot call gdwg::incremental_components<N>::connected on a node that "
+		                  "doesn't exist");
+	}
+	SECTION("mirrors a graph") {
+		auto const generator = gdwg::erdos_renyi_generator(500, 600, 5);
+		auto g = gdwg::graph<int, unsigned, gdwg::hashed_storage>();
+		auto c = gdwg::incremental_components<int, gdwg::hashed_storage>();
+		for (auto v = 0; v < 500; ++v) {
+			g.insert_node(v);
+			c.insert_node(v);
+		}
+		auto step = 0;
+		for (auto const& [src, dst, weight] : generator) {
+			auto const from = static_cast<int>(src);
+			auto const to = static_cast<int>(dst);
+			g.insert_edge(from, to, weight);
+			c.insert_edge(from, to);
+			if (++step % 50 == 0) {
+				auto const batch = gdwg::weakly_connected_components(g);
+				CHECK(c.component_count() == batch.count);
+				auto const nodes = g.nodes();
+				auto consistent = true;
+				for (auto i = std::size_t{0}; i < nodes.size(); i += 7) {
+					for (auto j = std::size_t{0}; j < nodes.size(); j += 11) {
+						consistent = consistent
+						             && c.connected(nodes[i], nodes[j])
+						                   == (batch.component[i] == batch.component[j]);
+					}
+				}
+				CHECK(consistent);
+			}
+		}
+		auto const rebuilt = gdwg::incremental_components<int, gdwg::hashed_storage>(g);
+		CHECK(rebuilt.component_count() == c.component_count());
+	}
+}
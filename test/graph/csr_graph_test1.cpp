@@ -0,0 +1,179 @@
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+/*
+    Testing Rationale & Approach
+    csr_graph is a read-only snapshot, so every accessor is checked against the answer the graph
+    it was built from gives for the same query. The dense id accessors are tested on their own as
+    they have no graph equivalent.
+*/
+
+namespace {
+	auto make_graph() -> gdwg::graph<std::string, int> {
+		auto g = gdwg::graph<std::string, int>{"A", "B", "C", "D", "E"};
+		g.insert_edge("B", "A", 3);
+		g.insert_edge("B", "C", 2);
+		g.insert_edge("B", "C", 7);
+		g.insert_edge("B", "B", -1);
+		g.insert_edge("D", "A", 4);
+		g.insert_edge("D", "E", 1);
+		return g;
+	}
+} // namespace
+
+TEST_CASE("CSR Constructor Unit Tests") {
+	SECTION("default") {
+		auto c = gdwg::csr_graph<int, int>();
+		CHECK(c.empty());
+		CHECK(c.begin() == c.end());
+	}
+	SECTION("empty graph") {
+		auto c = gdwg::csr_graph(gdwg::graph<int, int>());
+		CHECK(c.empty());
+		CHECK(c.node_count() == 0);
+		CHECK(c.edge_count() == 0);
+		CHECK(c.begin() == c.end());
+	}
+	SECTION("graph without edges") {
+		auto c = gdwg::csr_graph(gdwg::graph<int, int>{3, 1, 2});
+		CHECK(c.nodes() == std::vector<int>{1, 2, 3});
+		CHECK(c.edge_count() == 0);
+		CHECK(c.begin() == c.end());
+	}
+	SECTION("edge list") {
+		auto const g = make_graph();
+		// shuffled, with a repeated edge
+		auto const edges = std::vector<std::tuple<std::string, std::string, int>>{
+		   {"D", "E", 1},
+		   {"B", "C", 7},
+		   {"B", "B", -1},
+		   {"D", "A", 4},
+		   {"B", "C", 2},
+		   {"B", "A", 3},
+		   {"B", "C", 7},
+		};
+		auto const c = gdwg::csr_graph<std::string, int>({"E", "D", "C", "B", "A", "C"},
+		                                                 edges.begin(),
+		                                                 edges.end());
+		CHECK(c == gdwg::csr_graph(g));
+	}
+	SECTION("edge list with an unknown node") {
+		auto const edges = std::vector<std::tuple<int, int, int>>{{1, 2, 0}, {1, 3, 0}};
+		CHECK_THROWS_WITH((gdwg::csr_graph<int, int>({1, 2}, edges.begin(), edges.end())),
+		                  "Cannot build gdwg::csr_graph<N, E> from an edge whose src or dst node is "
+		                  "not in the graph");
+	}
+	SECTION("generator") {
+		auto const generator = gdwg::erdos_renyi_generator(50, 400, 9);
+		auto g = gdwg::graph<int, int>();
+		gdwg::insert_generated(g, generator);
+		auto const c = gdwg::csr_graph<int, int>::from_generator(generator);
+		CHECK(c.node_count() == 50);
+		// repeated edges are kept once, as the graph keeps them
+		CHECK(c == gdwg::csr_graph(g));
+	}
+}
+
+TEST_CASE("CSR Accessor Unit Tests") {
+	auto const g = make_graph();
+	auto const c = gdwg::csr_graph(g);
+
+	SECTION("is_node") {
+		CHECK(c.is_node("A"));
+		CHECK(c.is_node("E"));
+		CHECK(!c.is_node("F"));
+	}
+	SECTION("nodes") {
+		CHECK(c.nodes() == g.nodes());
+	}
+	SECTION("is_connected") {
+		CHECK(c.is_connected("B", "C"));
+		CHECK(c.is_connected("B", "B"));
+		CHECK(!c.is_connected("A", "B"));
+		CHECK_THROWS_WITH(c.is_connected("B", "F"),
+		                  "Cannot call gdwg::csr_graph<N, E>::is_connected if src or dst node don't "
+		                  "exist in the graph");
+	}
+	SECTION("weights") {
+		CHECK(c.weights("B", "C") == std::vector<int>{2, 7});
+		CHECK(c.weights("D", "E") == std::vector<int>{1});
+		CHECK(c.weights("A", "B").empty());
+		CHECK_THROWS_AS(c.weights("F", "A"), std::runtime_error);
+		auto const view = c.weights_view("B", "C");
+		CHECK(std::vector<int>(view.begin(), view.end()) == std::vector<int>{2, 7});
+		CHECK(c.weights_view("A", "B").empty());
+		CHECK_THROWS_AS(c.weights_view("F", "A"), std::runtime_error);
+	}
+	SECTION("connections") {
+		for (auto const& node : g.nodes()) {
+			CHECK(c.connections(node) == g.connections(node));
+		}
+		CHECK_THROWS_AS(c.connections("F"), std::runtime_error);
+	}
+	SECTION("find") {
+		auto it = c.find("B", "C", 7);
+		REQUIRE(it != c.end());
+		CHECK((*it).from == "B");
+		CHECK((*it).to == "C");
+		CHECK((*it).weight == 7);
+		CHECK(c.find("B", "C", 5) == c.end());
+		CHECK(c.find("F", "C", 7) == c.end());
+	}
+	SECTION("dense ids") {
+		CHECK(c.node_count() == 5);
+		CHECK(c.edge_count() == 6);
+		auto const b = c.id("B");
+		REQUIRE(b.has_value());
+		CHECK(c.node(*b) == "B");
+		CHECK(c.out_degree(*b) == 4);
+		CHECK(c.out_weights(*b)[0] == 3);
+		CHECK(c.node(c.out_edges(*b)[1]) == "B");
+		CHECK(!c.id("F").has_value());
+	}
+	SECTION("transpose") {
+		auto const t = c.transpose();
+		CHECK(t.weights("A", "B") == std::vector<int>{3});
+		CHECK(t.weights("C", "B") == std::vector<int>{2, 7});
+		CHECK(t.connections("A") == std::vector<std::string>{"B", "D"});
+		CHECK(t.transpose() == c);
+	}
+}
+
+TEST_CASE("CSR Iterator Unit Tests") {
+	auto const g = make_graph();
+	auto const c = gdwg::csr_graph(g);
+
+	SECTION("matches graph order") {
+		auto csr_it = c.begin();
+		for (auto const& [from, to, weight] : g) {
+			REQUIRE(csr_it != c.end());
+			CHECK((*csr_it).from == from);
+			CHECK((*csr_it).to == to);
+			CHECK((*csr_it).weight == weight);
+			++csr_it;
+		}
+		CHECK(csr_it == c.end());
+	}
+	SECTION("operator--") {
+		auto it = c.end();
+		--it;
+		CHECK((*it).from == "D");
+		CHECK((*it).to == "E");
+		--it;
+		--it;
+		CHECK((*it).from == "B");
+		CHECK((*it).to == "C");
+		CHECK((*it).weight == 7);
+		auto count = 1;
+		while (it != c.begin()) {
+			--it;
+			++count;
+		}
+		CHECK(count == 4);
+	}
+}
@@ -0,0 +1,164 @@
+#include "gdwg/edge_list.hpp"
+#include "gdwg/generators.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+/*
+    Testing Rationale & Approach
+    The parser is checked on small inputs in each dialect it accepts (SNAP with comments and no
+    weights, CSV with a header and CRLF endings, space separated floating point weights, named
+    nodes), and on one that is wrong in each way a line can be, which must be named by its line
+    number.
+    Batches and threads only change how the input is cut up, so a generated edge list of a few
+    megabytes, big enough to be split between threads, must come out the same for any batch
+    size down to a few bytes and any thread count. Loading into a graph must give the graph the
+    edges would give one at a time.
+*/
+
+namespace {
+	template<typename N, typename E>
+	using edges = std::vector<std::tuple<N, N, E>>;
+
+	template<typename N, typename E>
+	auto read(std::string const& text, gdwg::edge_list_options<E> const& options = {})
+	   -> edges<N, E> {
+		auto in = std::istringstream(text);
+		auto result = edges<N, E>();
+		gdwg::read_edge_list<N, E>(
+		   in,
+		   [&result](std::span<std::tuple<N, N, E> const> batch) {
+			   result.insert(result.end(), batch.begin(), batch.end());
+		   },
+		   options);
+		return result;
+	}
+
+	auto generated_text() -> std::string {
+		auto text = std::string();
+		for (auto const& [src, dst, weight] : gdwg::rmat_generator(16, 1 << 18, 11)) {
+			text += std::to_string(src) + '\t' + std::to_string(dst) + '\t'
+			        + std::to_string(weight) + '\n';
+		}
+		return text;
+	}
+} // namespace
+
+TEST_CASE("Edge List Unit Tests") {
+	SECTION("SNAP") {
+		auto const text = "# Directed graph: example.txt\n"
+		                  "# FromNodeId\tToNodeId\n"
+		                  "0\t1\n"
+		                  "\n"
+		                  "1\t2\n"
+		                  "2 0\n"
+		                  "2\t2";
+		CHECK(read<std::uint32_t, int>(text)
+		      == edges<std::uint32_t, int>{{0, 1, 1}, {1, 2, 1}, {2, 0, 1}, {2, 2, 1}});
+		CHECK(read<std::uint32_t, int>(text, {.default_weight = 0})
+		      == edges<std::uint32_t, int>{{0, 1, 0}, {1, 2, 0}, {2, 0, 0}, {2, 2, 0}});
+	}
+	SECTION("CSV") {
+		auto const text = "src,dst,weight\r\n"
+		                  "5,6,-2\r\n"
+		                  "6, 5 , 3\r\n"
+		                  "% not a comment here\r\n";
+		CHECK_THROWS_WITH((read<int, int>(text, {.delimiter = ',', .header_lines = 1})),
+		                  "Cannot call gdwg::read_edge_list on input with a malformed edge on line "
+		                  "4");
+		CHECK(read<int, int>(text, {.delimiter = ',', .comment = '%', .header_lines = 1})
+		      == edges<int, int>{{5, 6, -2}, {6, 5, 3}});
+	}
+	SECTION("floating point weights") {
+		CHECK(read<std::int64_t, double>("-3 4 0.25\n4 -3 1e3\n  7   7   -1.5  \n")
+		      == edges<std::int64_t, double>{{-3, 4, 0.25}, {4, -3, 1e3}, {7, 7, -1.5}});
+	}
+	SECTION("named nodes") {
+		auto const text = "# src\tdst\tweight\n"
+		                  "https://a.example/x?q=1\thttps://b.example/\t3\n"
+		                  "https://b.example/  https://a.example/x?q=1\n";
+		CHECK(read<std::string, int>(text)
+		      == edges<std::string, int>{{"https://a.example/x?q=1", "https://b.example/", 3},
+		                                 {"https://b.example/", "https://a.example/x?q=1", 1}});
+		CHECK(read<std::string, double>("a,b,0.5\nb , c\n", {.delimiter = ','})
+		      == edges<std::string, double>{{"a", "b", 0.5}, {"b", "c", 1.0}});
+		CHECK_THROWS_WITH((read<std::string, int>("a\tb\n,\tb\n", {.delimiter = ','})),
+		                  "Cannot call gdwg::read_edge_list on input with a malformed edge on line "
+		                  "2");
+
+		auto in = std::istringstream("x\ty\t2\ny\tz\t4\n");
+		auto g = gdwg::graph<std::string, int>();
+		gdwg::load_edge_list(g, in);
+		CHECK(g.nodes() == std::vector<std::string>{"x", "y", "z"});
+		CHECK(g.weights("y", "z") == std::vector<int>{4});
+	}
+	SECTION("malformed lines") {
+		for (auto const* const line : {"1\n", "1\t\n", "a\t2\n", "1\t2\t3\t4\n", "1\t2\tx\n",
+		                               "1\t2\t3x\n", "4294967296\t1\n", "-1\t1\n"})
+		{
+			CHECK_THROWS_WITH((read<std::uint32_t, int>(std::string("0\t1\n# comment\n") + line)),
+			                  "Cannot call gdwg::read_edge_list on input with a malformed edge on "
+			                  "line 3");
+		}
+	}
+	SECTION("an empty tab-delimited field") {
+		for (auto const* const line : {"1\t\t2\n", "1\t\t2\t3\n", "\t1\t2\n", "1\t2\t\t3\n"}) {
+			CHECK_THROWS_WITH((read<std::uint32_t, int>(std::string("0\t1\n") + line)),
+			                  "Cannot call gdwg::read_edge_list on input with a malformed edge on "
+			                  "line 2");
+		}
+		CHECK_THROWS_WITH((read<std::string, int>("a\t\tb\n")),
+		                  "Cannot call gdwg::read_edge_list on input with a malformed edge on line "
+		                  "1");
+		CHECK(read<std::uint32_t, int>("1 \t 2\t 3\n\t\n")
+		      == edges<std::uint32_t, int>{{1, 2, 3}});
+	}
+	SECTION("batches and threads don't change the result") {
+		auto const text = generated_text();
+		auto const expected = read<std::uint32_t, std::uint32_t>(text, {.threads = 1});
+		CHECK(expected.size() == std::size_t{1} << 18);
+		for (auto const batch_bytes :
+		     {std::size_t{5}, std::size_t{4096}, text.size() / 3, text.size() * 2})
+		{
+			for (auto const threads : {1U, 4U}) {
+				auto const result = read<std::uint32_t, std::uint32_t>(
+				   text,
+				   {.batch_bytes = batch_bytes, .threads = threads});
+				CHECK(result == expected);
+			}
+		}
+	}
+	SECTION("stats") {
+		auto in = std::istringstream("# two edges\n0\t1\t5\n1\t0\t6\n");
+		auto batches = 0;
+		auto const stats = gdwg::read_edge_list<int, int>(in, [&batches](auto) { ++batches; });
+		CHECK(batches == 1);
+		CHECK(stats.bytes == 24);
+		CHECK(stats.lines == 3);
+		CHECK(stats.edges == 2);
+		CHECK(stats.megabytes_per_second() >= 0);
+		CHECK(stats.edges_per_second() >= 0);
+	}
+	SECTION("loading into a graph") {
+		auto const path = std::filesystem::temp_directory_path() / "gdwg_edge_list_test1";
+		std::ofstream(path) << "1\t2\t10\n2\t3\t20\n1\t2\t10\n1\t2\t5\n9\t9\t0\n";
+		auto g = gdwg::graph<int, int>{4};
+		auto const stats = gdwg::load_edge_list(g, path, {.batch_bytes = 8});
+		std::filesystem::remove(path);
+		auto expected = gdwg::graph<int, int>{1, 2, 3, 4, 9};
+		expected.insert_edge(1, 2, 10);
+		expected.insert_edge(1, 2, 5);
+		expected.insert_edge(2, 3, 20);
+		expected.insert_edge(9, 9, 0);
+		CHECK(g == expected);
+		CHECK(stats.edges == 5);
+		CHECK_THROWS_WITH(gdwg::load_edge_list(g, path),
+		                  "Cannot call gdwg::load_edge_list on a file that can't be opened");
+	}
+}
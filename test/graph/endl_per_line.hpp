@@ -0,0 +1,24 @@
+#ifndef GDWG_TEST_ENDL_PER_LINE_HPP
+#define GDWG_TEST_ENDL_PER_LINE_HPP
+#include "gdwg/graph.hpp"
+
+#include <ostream>
+
+namespace gdwg::test {
+	// operator<< as it was, one std::endl per line, written against the public interface. The
+	// format tests check the buffered operator<< against it, and the format benchmark times it.
+	template<typename N, typename E>
+	auto endl_per_line(std::ostream& os, gdwg::graph<N, E> const& g) -> std::ostream& {
+		auto edge = g.begin();
+		for (auto const& node : g.nodes()) {
+			os << node << " (" << std::endl;
+			for (; edge != g.end() && (*edge).from == node; ++edge) {
+				os << "  " << (*edge).to << " | " << (*edge).weight << std::endl;
+			}
+			os << ")" << std::endl;
+		}
+		return os;
+	}
+} // namespace gdwg::test
+
+#endif // GDWG_TEST_ENDL_PER_LINE_HPP
@@ -0,0 +1,146 @@
+#include "gdwg/format.hpp"
+#include "gdwg/generators.hpp"
+#include "graph/endl_per_line.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <iomanip>
+#include <ios>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <vector>
+/*
+    Testing Rationale & Approach
+    operator<< must write exactly the text it wrote when every line ended in std::endl, so each
+    test compares it with that original loop, kept in endl_per_line.hpp, on the same stream
+    settings. The buffered path is taken for numbers and strings on a default stream, so it is
+    checked on awkward floating point values at several precisions and on a generated graph
+    spanning many blocks; changing any stream setting must fall back to streaming each value and
+    still match. The formatters must give the same text.
+*/
+
+namespace {
+	template<typename N, typename E, typename Setup>
+	auto same_text(gdwg::graph<N, E> const& g, Setup setup) -> bool {
+		auto expected = std::ostringstream();
+		auto actual = std::ostringstream();
+		setup(expected);
+		setup(actual);
+		gdwg::test::endl_per_line(expected, g);
+		actual << g;
+		return expected.str() == actual.str();
+	}
+
+	template<typename N, typename E>
+	auto same_text(gdwg::graph<N, E> const& g) -> bool {
+		return same_text(g, [](std::ostream&) {});
+	}
+
+	// Groups thousands with '.' and writes ',' for the decimal point.
+	struct comma_decimals : std::numpunct<char> {
+	protected:
+		auto do_decimal_point() const -> char override {
+			return ',';
+		}
+		auto do_thousands_sep() const -> char override {
+			return '.';
+		}
+		auto do_grouping() const -> std::string override {
+			return "\3";
+		}
+	};
+
+	auto awkward_weights() -> gdwg::graph<int, double> {
+		auto g = gdwg::graph<int, double>{-7, 0, 1, 100000};
+		auto const weights = std::vector<double>{0.0,
+		                                         -0.0,
+		                                         0.1,
+		                                         1.0 / 3,
+		                                         -2.5e-5,
+		                                         123456.0,
+		                                         1234567.0,
+		                                         1e300,
+		                                         std::numeric_limits<double>::min(),
+		                                         std::numeric_limits<double>::denorm_min(),
+		                                         std::numeric_limits<double>::infinity(),
+		                                         -std::numeric_limits<double>::infinity()};
+		for (auto const weight : weights) {
+			g.insert_edge(-7, 100000, weight);
+			g.insert_edge(1, -7, -weight);
+		}
+		return g;
+	}
+} // namespace
+
+TEST_CASE("Format Unit Tests") {
+	SECTION("number and string nodes") {
+		auto g1 = gdwg::graph<std::string, int>{"A", "B", "C", ""};
+		g1.insert_edge("A", "B", std::numeric_limits<int>::min());
+		g1.insert_edge("A", "", 0);
+		g1.insert_edge("C", "C", std::numeric_limits<int>::max());
+		CHECK(same_text(g1));
+
+		auto g2 = gdwg::graph<std::uint64_t, std::string>{0, 18446744073709551615U};
+		g2.insert_edge(0, 18446744073709551615U, "to the end");
+		g2.insert_edge(0, 0, "");
+		CHECK(same_text(g2));
+		CHECK(same_text(gdwg::graph<int, int>()));
+	}
+	SECTION("floating point") {
+		auto const g = awkward_weights();
+		CHECK(same_text(g));
+		for (auto const precision : {0, 1, 3, 10, 17, 40}) {
+			CHECK(same_text(g, [precision](std::ostream& os) { os.precision(precision); }));
+		}
+		auto g2 = gdwg::graph<float, long double>{0.5F, 1e-10F};
+		g2.insert_edge(0.5F, 1e-10F, 1.0L / 7);
+		CHECK(same_text(g2));
+	}
+	SECTION("stream settings fall back to streaming each value") {
+		auto const g = awkward_weights();
+		CHECK(same_text(g, [](std::ostream& os) { os << std::fixed; }));
+		CHECK(same_text(g, [](std::ostream& os) { os << std::scientific << std::uppercase; }));
+		CHECK(same_text(g, [](std::ostream& os) { os << std::showpos << std::hex; }));
+		CHECK(same_text(g, [](std::ostream& os) { os << std::setw(12); }));
+		CHECK(same_text(g, [](std::ostream& os) { os.precision(1000); }));
+
+		auto g2 = gdwg::graph<char, bool>{'a', 'b'};
+		g2.insert_edge('a', 'b', true);
+		g2.insert_edge('b', 'a', false);
+		CHECK(same_text(g2));
+		CHECK(same_text(g2, [](std::ostream& os) { os << std::boolalpha; }));
+	}
+	SECTION("many blocks") {
+		auto g = gdwg::graph<std::uint32_t, double>();
+		auto const generator = gdwg::rmat_generator(12, 1 << 15, 5);
+		for (auto i = std::uint32_t{0}; i < generator.node_count(); ++i) {
+			g.insert_node(i);
+		}
+		for (auto const& [src, dst, weight] : generator) {
+			g.insert_edge(static_cast<std::uint32_t>(src),
+			              static_cast<std::uint32_t>(dst),
+			              static_cast<double>(weight) / 7);
+		}
+		CHECK(same_text(g));
+	}
+#if defined(GDWG_WITH_FMT)
+	SECTION("fmt") {
+		auto const g = awkward_weights();
+		auto expected = std::ostringstream();
+		gdwg::test::endl_per_line(expected, g);
+		CHECK(fmt::format("{}", g) == expected.str());
+		CHECK(fmt::format("<{}>", gdwg::graph<int, int>()) == "<>");
+	}
+	SECTION("fmt ignores the global locale") {
+		auto g = gdwg::graph<int, double>{1000000, 2};
+		g.insert_edge(1000000, 2, 1.5);
+		auto const previous =
+		   std::locale::global(std::locale(std::locale::classic(), new comma_decimals()));
+		auto const text = fmt::format("{}", g);
+		std::locale::global(previous);
+		CHECK(text == "2 (\n)\n1000000 (\n  2 | 1.5\n)\n");
+	}
+#endif
+}
@@ -0,0 +1,141 @@
+#include "gdwg/generators.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <vector>
+/*
+    Testing Rationale & Approach
+    Generators are used to compare results across runs, so the important properties are that a
+    seed always gives the same edges, that edges stay within the node range, and that each model
+    has its expected shape. Shapes are checked with bounds loose enough to hold for any seed
+    rather than exact values.
+*/
+
+namespace {
+	template<typename Generator>
+	auto collect(Generator const& generator) -> std::vector<gdwg::generated_edge> {
+		return std::vector<gdwg::generated_edge>(generator.begin(), generator.end());
+	}
+
+	template<typename Generator>
+	auto out_degrees(Generator const& generator) -> std::vector<std::uint64_t> {
+		auto result = std::vector<std::uint64_t>(generator.node_count());
+		for (auto const& edge : generator) {
+			++result[edge.src];
+		}
+		return result;
+	}
+
+	template<typename Generator>
+	auto in_range(Generator const& generator, std::uint32_t max_weight) -> bool {
+		for (auto const& edge : generator) {
+			if (edge.src >= generator.node_count() || edge.dst >= generator.node_count()
+			    || edge.weight < 1 || edge.weight > max_weight)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+} // namespace
+
+TEST_CASE("Generator Determinism Unit Tests") {
+	SECTION("a seed always gives the same edges") {
+		CHECK(collect(gdwg::rmat_generator(8, 1000, 1)) == collect(gdwg::rmat_generator(8, 1000, 1)));
+		CHECK(collect(gdwg::erdos_renyi_generator(100, 1000, 1))
+		      == collect(gdwg::erdos_renyi_generator(100, 1000, 1)));
+		CHECK(collect(gdwg::barabasi_albert_generator(100, 4, 1))
+		      == collect(gdwg::barabasi_albert_generator(100, 4, 1)));
+		CHECK(collect(gdwg::grid_generator(5, 7, 1)) == collect(gdwg::grid_generator(5, 7, 1)));
+	}
+	SECTION("different seeds give different edges") {
+		CHECK(collect(gdwg::rmat_generator(8, 1000, 1)) != collect(gdwg::rmat_generator(8, 1000, 2)));
+		CHECK(collect(gdwg::erdos_renyi_generator(100, 1000, 1))
+		      != collect(gdwg::erdos_renyi_generator(100, 1000, 2)));
+		CHECK(collect(gdwg::barabasi_albert_generator(100, 4, 1))
+		      != collect(gdwg::barabasi_albert_generator(100, 4, 2)));
+	}
+	SECTION("edges can be generated out of order") {
+		auto const generator = gdwg::rmat_generator(10, 100, 3);
+		auto const edges = collect(generator);
+		CHECK(generator.edge(57) == edges[57]);
+		CHECK(generator.edge(0) == edges[0]);
+	}
+}
+
+TEST_CASE("Generator Shape Unit Tests") {
+	SECTION("rmat") {
+		auto const generator = gdwg::rmat_generator(10, 16384, 4, 0.57, 0.19, 0.19, 10);
+		CHECK(generator.node_count() == 1024);
+		CHECK(generator.edge_count() == 16384);
+		CHECK(in_range(generator, 10));
+		// the hub at id 0 takes far more than the average of 16 edges
+		CHECK(out_degrees(generator)[0] > 160);
+		CHECK_THROWS_AS(gdwg::rmat_generator(8, 10, 1, 0.5, 0.5, 0.5), std::invalid_argument);
+	}
+	SECTION("erdos renyi") {
+		auto const generator = gdwg::erdos_renyi_generator(64, 64 * 100, 5);
+		CHECK(in_range(generator, 1000));
+		auto const degrees = out_degrees(generator);
+		for (auto const degree : degrees) {
+			CHECK(degree > 40);
+			CHECK(degree < 160);
+		}
+	}
+	SECTION("barabasi albert") {
+		auto const generator = gdwg::barabasi_albert_generator(1000, 3, 6);
+		CHECK(generator.edge_count() == 3000);
+		CHECK(in_range(generator, 1000));
+		auto in_degrees = std::vector<std::uint64_t>(generator.node_count());
+		for (auto const& edge : generator) {
+			// each node only attaches to nodes that arrived before it, or itself
+			CHECK(edge.dst <= edge.src);
+			++in_degrees[edge.dst];
+		}
+		CHECK(out_degrees(generator) == std::vector<std::uint64_t>(1000, 3));
+		// early nodes accumulate links, so node 0 is far above the average in-degree of 3
+		CHECK(in_degrees[0] > 30);
+	}
+	SECTION("grid") {
+		auto const generator = gdwg::grid_generator(3, 4, 7, 5);
+		CHECK(generator.node_count() == 12);
+		CHECK(generator.edge_count() == 2 * (3 * 3 + 2 * 4));
+		CHECK(in_range(generator, 5));
+		for (auto const& edge : generator) {
+			auto const row_step = edge.src / 4 != edge.dst / 4;
+			auto const distance = edge.src > edge.dst ? edge.src - edge.dst : edge.dst - edge.src;
+			CHECK(distance == (row_step ? 4U : 1U));
+		}
+		// corners have two neighbours and the middle cells four
+		CHECK(out_degrees(generator)
+		      == std::vector<std::uint64_t>{2, 3, 3, 2, 3, 4, 4, 3, 2, 3, 3, 2});
+	}
+	SECTION("a max_weight of 0 leaves no weight to choose") {
+		CHECK_THROWS_WITH(gdwg::rmat_generator(8, 10, 1, 0.57, 0.19, 0.19, 0),
+		                  "Cannot construct gdwg::rmat_generator with a max_weight of 0");
+		CHECK_THROWS_WITH(gdwg::erdos_renyi_generator(8, 10, 1, 0),
+		                  "Cannot construct gdwg::erdos_renyi_generator with a max_weight of 0");
+		CHECK_THROWS_WITH(gdwg::barabasi_albert_generator(8, 2, 1, 0),
+		                  "Cannot construct gdwg::barabasi_albert_generator with a max_weight of 0");
+		CHECK_THROWS_WITH(gdwg::grid_generator(2, 2, 1, 0),
+		                  "Cannot construct gdwg::grid_generator with a max_weight of 0");
+		CHECK((*gdwg::grid_generator(2, 2, 1, 1).begin()).weight == 1);
+	}
+}
+
+TEST_CASE("Insert Generated Unit Tests") {
+	auto const generator = gdwg::grid_generator(4, 4, 8);
+	auto chunked = gdwg::graph<int, int>();
+	// a chunk size smaller than the stream inserts it over several insert_edges calls
+	CHECK(gdwg::insert_generated(chunked, generator, 5) == generator.edge_count());
+	CHECK(chunked.nodes().size() == 16);
+	CHECK(chunked.connections(5) == std::vector<int>{1, 4, 6, 9});
+
+	auto single = gdwg::graph<int, int>();
+	for (auto const& [src, dst, weight] : generator) {
+		single.insert_node(static_cast<int>(src));
+		single.insert_node(static_cast<int>(dst));
+		single.insert_edge(static_cast<int>(src), static_cast<int>(dst), static_cast<int>(weight));
+	}
+	CHECK(chunked == single);
+}
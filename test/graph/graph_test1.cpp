@@ -1,8 +1,14 @@
 #include "gdwg/graph.hpp"
 
 #include <catch2/catch.hpp>
+#include <cstddef>
+#include <iterator>
 #include <list>
+#include <random>
+#include <ranges>
 #include <sstream>
+#include <string>
+#include <tuple>
 #include <vector>
 /*
     Testing Rationale & Approach
@@ -121,6 +127,12 @@ TEST_CASE("Accessor Unit Tests") {
 		g1.insert_edge("A", "B", 5);
 		CHECK(g1.is_connected("A", "B") == true);
 		CHECK(g1.is_connected("B", "A") == false);
+		// destinations inserted out of order, on both sides of the one looked up
+		g1.insert_edge("A", "Marko", 1);
+		g1.insert_edge("A", "A", 2);
+		CHECK(g1.is_connected("A", "A") == true);
+		CHECK(g1.is_connected("A", "Marko") == true);
+		CHECK(g1.is_connected("Marko", "A") == false);
 
 		CHECK_THROWS_AS(g1.is_connected("C", "A"), std::runtime_error);
 		CHECK_THROWS_WITH(g1.is_connected("C", "A"),
@@ -148,6 +160,13 @@ TEST_CASE("Accessor Unit Tests") {
 		g.insert_edge("hello", "are", 2);
 		auto src_weights = g.weights("hello", "are");
 		CHECK(src_weights == std::vector<int>{2, 8});
+		auto const view = g.weights_view("hello", "are");
+		CHECK(std::vector<int>(view.begin(), view.end()) == std::vector<int>{2, 8});
+		CHECK(g.weights_view("hello", "how").front() == 5);
+		CHECK(g.weights_view("how", "hello").empty());
+		CHECK_THROWS_WITH(g.weights_view("are", "C"),
+		                  "Cannot call gdwg::graph<N, E>::weights if src or dst node don't exist in "
+		                  "the graph");
 
 		CHECK_THROWS_AS(g.weights("C", "are"), std::runtime_error);
 		CHECK_THROWS_WITH(g.weights("C", "are"),
@@ -197,6 +216,49 @@ TEST_CASE("Accessor Unit Tests") {
 		                  "Cannot call gdwg::graph<N, E>::connections if src doesn't exist in the "
 		                  "graph");
 	}
+	SECTION("connections_view") {
+		auto g = gdwg::graph<std::string, int>{"hello", "how", "are", "you?"};
+		g.insert_edge("hello", "are", 8);
+		g.insert_edge("hello", "are", 2);
+		g.insert_edge("hello", "you?", 1);
+		g.insert_edge("hello", "you?", 3);
+		g.insert_edge("hello", "hello", 1);
+		g.insert_edge("how", "hello", 4);
+
+		STATIC_REQUIRE(std::ranges::forward_range<decltype(g.connections_view("hello"))>);
+		STATIC_REQUIRE(std::ranges::view<decltype(g.connections_view("hello"))>);
+		auto const view = g.connections_view("hello");
+		auto const connections = std::vector<std::string>(view.begin(), view.end());
+		CHECK(connections == std::vector<std::string>{"are", "hello", "you?"});
+		// destinations are read in place from the node table, so every view names the same one
+		CHECK(&*std::next(view.begin()) == &*g.connections_view("how").begin());
+		CHECK(g.connections_view("are").empty());
+		CHECK(gdwg::graph<std::string, int>::connection_view().empty());
+		// a view, so it pipes through the standard adaptors
+		auto const lengths = g.connections_view("hello")
+		                     | std::views::transform([](std::string const& dst) { return dst.size(); });
+		CHECK(std::vector<std::size_t>(lengths.begin(), lengths.end())
+		      == std::vector<std::size_t>{3, 5, 4});
+		CHECK_THROWS_WITH(g.connections_view("C"),
+		                  "Cannot call gdwg::graph<N, E>::connections if src doesn't exist in the "
+		                  "graph");
+	}
+	SECTION("out_degree") {
+		auto g = gdwg::graph<std::string, int>{"hello", "how", "are"};
+		g.insert_edge("hello", "are", 8);
+		g.insert_edge("hello", "are", 2);
+		g.insert_edge("hello", "how", 1);
+		CHECK(g.out_degree("hello") == 3);
+		CHECK(g.distinct_out_degree("hello") == 2);
+		CHECK(g.out_degree("are") == 0);
+		CHECK(g.distinct_out_degree("are") == 0);
+		CHECK_THROWS_WITH(g.out_degree("C"),
+		                  "Cannot call gdwg::graph<N, E>::out_degree if src doesn't exist in the "
+		                  "graph");
+		CHECK_THROWS_WITH(g.distinct_out_degree("C"),
+		                  "Cannot call gdwg::graph<N, E>::distinct_out_degree if src doesn't exist "
+		                  "in the graph");
+	}
 }
 TEST_CASE("Modifier Unit Tests") {
 	SECTION("insert_node") {
@@ -783,4 +845,327 @@ TEST_CASE("Iterator Unit Tests") {
 		++it2;
 		CHECK(it == it2);
 	}
+
+	SECTION("dereferencing refers into the graph") {
+		auto g = gdwg::graph<std::string, int>{"A", "B"};
+		g.insert_edge("A", "B", 1);
+		g.insert_edge("A", "A", 2);
+		auto const first = *g.begin();
+		auto const second = *std::next(g.begin());
+		// both edges leave A and the first is a self loop, so all three refer to one stored node
+		CHECK(&first.from == &second.from);
+		CHECK(&first.to == &first.from);
+		CHECK(std::next(g.begin())->to == "B");
+		CHECK(std::next(g.begin())->weight == 1);
+		for (auto const& [from, to, weight] : g) {
+			CHECK(from == "A");
+			CHECK(g.is_connected(from, to));
+		}
+		// converting to value_type copies the edge out of the graph
+		auto const copy = static_cast<decltype(g)::iterator::value_type>(*g.begin());
+		g.clear();
+		CHECK(copy.from == "A");
+		CHECK(copy.to == "A");
+		CHECK(copy.weight == 2);
+	}
+}
+
+TEST_CASE("Incoming Edge Unit Tests") {
+	// erase_node, replace_node and merge_replace_node only visit the nodes with an edge into the
+	// target, so these check the incoming edges stay correct across a chain of modifications
+	auto g = gdwg::graph<std::string, int>{"A", "B", "C", "D"};
+	g.insert_edge("A", "B", 1);
+	g.insert_edge("A", "B", 2);
+	g.insert_edge("B", "B", 3);
+	g.insert_edge("C", "B", 4);
+	g.insert_edge("B", "D", 5);
+	g.insert_edge("D", "A", 6);
+
+	SECTION("replace then erase") {
+		CHECK(g.replace_node("B", "E") == true);
+		CHECK(g.weights("A", "E") == std::vector<int>{1, 2});
+		CHECK(g.weights("E", "E") == std::vector<int>{3});
+		CHECK(g.erase_node("E") == true);
+		CHECK(g.connections("A").empty());
+		CHECK(g.connections("C").empty());
+		CHECK(g.connections("D") == std::vector<std::string>{"A"});
+	}
+	SECTION("merge then erase") {
+		g.merge_replace_node("B", "A");
+		CHECK(g.weights("A", "A") == std::vector<int>{1, 2, 3});
+		CHECK(g.weights("C", "A") == std::vector<int>{4});
+		CHECK(g.weights("D", "A") == std::vector<int>{6});
+		CHECK(g.erase_node("A") == true);
+		CHECK(g.connections("C").empty());
+		CHECK(g.connections("D").empty());
+	}
+	SECTION("erasing one of several edges keeps the source incoming") {
+		CHECK(g.erase_edge("A", "B", 1) == true);
+		CHECK(g.erase_node("B") == true);
+		CHECK(g.connections("A").empty());
+	}
+	SECTION("erase by iterator") {
+		g.erase_edge(g.find("A", "B", 1));
+		g.erase_edge(g.find("A", "B", 2));
+		CHECK(g.replace_node("B", "E") == true);
+		CHECK(g.connections("A").empty());
+		CHECK(g.connections("C") == std::vector<std::string>{"E"});
+	}
+}
+
+TEST_CASE("Interned Node Unit Tests") {
+	// edges refer to nodes by an internal id, so these check ids are translated back correctly
+	// and never leak between graphs or between erased and re-inserted nodes
+	SECTION("ids of erased nodes are reused") {
+		auto g = gdwg::graph<std::string, int>{"A", "B", "C"};
+		g.insert_edge("A", "B", 1);
+		g.insert_edge("C", "A", 2);
+		CHECK(g.erase_node("B") == true);
+		CHECK(g.insert_node("D") == true);
+		CHECK(g.insert_edge("A", "D", 3) == true);
+		CHECK(g.connections("A") == std::vector<std::string>{"D"});
+		CHECK(g.weights("C", "A") == std::vector<int>{2});
+		CHECK(g.erase_node("A") == true);
+		CHECK(g.insert_node("B") == true);
+		CHECK(g.connections("C").empty());
+		CHECK(g.connections("B").empty());
+	}
+	SECTION("equality does not depend on insertion order") {
+		auto g1 = gdwg::graph<std::string, int>{"A", "B", "C"};
+		auto g2 = gdwg::graph<std::string, int>{"C", "B", "A"};
+		g1.insert_edge("A", "B", 1);
+		g1.insert_edge("A", "C", 1);
+		g2.insert_edge("A", "C", 1);
+		g2.insert_edge("A", "B", 1);
+		CHECK(g1 == g2);
+		g2.erase_edge("A", "B", 1);
+		g2.insert_edge("A", "B", 2);
+		CHECK(!(g1 == g2));
+	}
+	SECTION("copies are independent") {
+		auto g1 = gdwg::graph<std::string, int>{"A", "B"};
+		g1.insert_edge("A", "B", 1);
+		auto g2 = g1;
+		g1.replace_node("B", "C");
+		CHECK(g2.connections("A") == std::vector<std::string>{"B"});
+		CHECK(g1.connections("A") == std::vector<std::string>{"C"});
+		g2.insert_edge("A", "A", 1);
+		CHECK(g1.weights("A", "A").empty());
+	}
+	SECTION("renaming keeps edges ordered by value") {
+		auto g = gdwg::graph<std::string, int>{"A", "B", "C", "D"};
+		g.insert_edge("A", "B", 1);
+		g.insert_edge("A", "C", 1);
+		g.insert_edge("A", "D", 1);
+		g.replace_node("B", "E");
+		CHECK(g.connections("A") == std::vector<std::string>{"C", "D", "E"});
+		auto out = std::ostringstream();
+		out << g;
+		CHECK(out.str() == "A (\n  C | 1\n  D | 1\n  E | 1\n)\nC (\n)\nD (\n)\nE (\n)\n");
+	}
+}
+
+TEST_CASE("Bulk Insert Unit Tests") {
+	SECTION("matches single inserts") {
+		auto const edges = std::vector<std::tuple<std::string, std::string, int>>{
+		   {"D", "B", 5},
+		   {"A", "B", 1},
+		   {"D", "B", 4},
+		   {"A", "B", 1},
+		   {"B", "B", -1},
+		   {"D", "A", 2},
+		};
+		auto bulk = gdwg::graph<std::string, int>{"A", "B", "C", "D"};
+		CHECK(bulk.insert_edges(edges.begin(), edges.end()) == 5);
+
+		auto single = gdwg::graph<std::string, int>{"A", "B", "C", "D"};
+		for (auto const& [src, dst, weight] : edges) {
+			single.insert_edge(src, dst, weight);
+		}
+		CHECK(bulk == single);
+		CHECK(bulk.weights("D", "B") == std::vector<int>{4, 5});
+		// incoming edges are tracked, so erasing a destination removes the bulk inserted edges
+		CHECK(bulk.erase_node("B") == true);
+		CHECK(bulk.connections("D") == std::vector<std::string>{"A"});
+	}
+	SECTION("merges with existing edges") {
+		auto g = gdwg::graph<int, int>{1, 2, 3};
+		g.insert_edge(1, 2, 5);
+		g.insert_edge(1, 3, 1);
+		auto const edges = std::vector<std::tuple<int, int, int>>{{1, 2, 5}, {1, 2, 3}, {2, 1, 0}};
+		CHECK(g.insert_edges(edges.begin(), edges.end()) == 2);
+		CHECK(g.weights(1, 2) == std::vector<int>{3, 5});
+		CHECK(g.connections(1) == std::vector<int>{2, 3});
+		CHECK(g.connections(2) == std::vector<int>{1});
+	}
+	SECTION("missing nodes") {
+		auto g = gdwg::graph<int, int>{1, 2};
+		auto const edges = std::vector<std::tuple<int, int, int>>{{1, 2, 1}, {1, 3, 1}};
+		CHECK_THROWS_WITH(g.insert_edges(edges.begin(), edges.end()),
+		                  "Cannot call gdwg::graph<N, E>::insert_edge when either src or dst node "
+		                  "does not exist");
+		CHECK(g.is_connected(1, 2) == false);
+
+		CHECK(g.insert_edges(edges.begin(), edges.end(), true) == 2);
+		CHECK(g.nodes() == std::vector<int>{1, 2, 3});
+		CHECK(g.connections(1) == std::vector<int>{2, 3});
+	}
+	SECTION("empty range") {
+		auto g = gdwg::graph<int, int>{1};
+		auto const edges = std::vector<std::tuple<int, int, int>>{};
+		CHECK(g.insert_edges(edges.begin(), edges.end()) == 0);
+		CHECK(g.begin() == g.end());
+	}
+}
+
+TEST_CASE("Mutation Batch Unit Tests") {
+	SECTION("results match single calls") {
+		auto batched = gdwg::graph<std::string, int>{"A", "B", "C"};
+		batched.insert_edge("A", "B", 1);
+		auto single = batched;
+
+		auto batch = batched.batch();
+		CHECK(batch.empty());
+		batch.insert_edge("A", "B", 1);
+		batch.insert_edge("A", "C", 2);
+		batch.erase_edge("A", "B", 1);
+		batch.erase_edge("A", "B", 1);
+		batch.insert_edge("A", "B", 1);
+		batch.insert_node("D");
+		batch.insert_edge("D", "A", 3);
+		batch.erase_edge("A", "C", 2);
+		batch.insert_edge("C", "C", 4);
+		batch.replace_node("C", "E");
+		batch.insert_edge("E", "A", 5);
+		CHECK(batch.size() == 11);
+
+		auto const results = batch.commit();
+		CHECK(batch.empty());
+		auto const expected = std::vector<bool>{
+		   single.insert_edge("A", "B", 1),
+		   single.insert_edge("A", "C", 2),
+		   single.erase_edge("A", "B", 1),
+		   single.erase_edge("A", "B", 1),
+		   single.insert_edge("A", "B", 1),
+		   single.insert_node("D"),
+		   single.insert_edge("D", "A", 3),
+		   single.erase_edge("A", "C", 2),
+		   single.insert_edge("C", "C", 4),
+		   single.replace_node("C", "E"),
+		   single.insert_edge("E", "A", 5),
+		};
+		CHECK(results == expected);
+		CHECK(batched == single);
+		CHECK(batched.connections("A") == std::vector<std::string>{"B"});
+		CHECK(batched.connections("E") == std::vector<std::string>{"A", "E"});
+	}
+	SECTION("reverse index is maintained") {
+		auto g = gdwg::graph<int, int>{1, 2, 3};
+		g.insert_edge(1, 2, 1);
+		g.insert_edge(1, 2, 2);
+		auto batch = g.batch();
+		auto const erased = batch.erase_edge(1, 2, 1);
+		auto const inserted = batch.insert_edge(3, 2, 1);
+		auto const merged = batch.merge_replace_node(3, 1);
+		auto const results = batch.commit();
+		CHECK(results[erased] == true);
+		CHECK(results[inserted] == true);
+		CHECK(results[merged] == true);
+		CHECK(g.weights(1, 2) == std::vector<int>{1, 2});
+		CHECK(g.erase_node(2) == true);
+		CHECK(g.begin() == g.end());
+	}
+	SECTION("missing nodes") {
+		auto g = gdwg::graph<int, int>{1, 2};
+		auto batch = g.batch();
+		batch.insert_edge(1, 2, 1);
+		batch.insert_edge(1, 3, 1);
+		CHECK_THROWS_WITH(batch.commit(),
+		                  "Cannot call gdwg::graph<N, E>::insert_edge when either src or dst node "
+		                  "does not exist");
+		// the run of edge operations is checked before any of it is applied
+		CHECK(g.is_connected(1, 2) == false);
+		CHECK(batch.empty());
+
+		batch.erase_edge(3, 1, 1);
+		CHECK_THROWS_WITH(batch.commit(),
+		                  "Cannot call gdwg::graph<N, E>::erase_edge on src or dst if they don't "
+		                  "exist in the graph");
+	}
+}
+
+TEST_CASE("First Edge Unit Tests") {
+	// begin() is cached rather than searched for, so it is checked against a search of the graph
+	// after every modification of a long random sequence
+	auto const expected_begin = [](gdwg::graph<int, int> const& g) {
+		for (auto const node : g.nodes()) {
+			auto const connections = g.connections(node);
+			if (!connections.empty()) {
+				return g.find(node, connections.front(), g.weights(node, connections.front()).front());
+			}
+		}
+		return g.end();
+	};
+	SECTION("renaming the first source") {
+		auto renamed = gdwg::graph<int, int>{1, 2, 3};
+		renamed.insert_edge(1, 3, 1);
+		renamed.insert_edge(2, 1, 1);
+		renamed.replace_node(1, 5);
+		CHECK(renamed.begin() == renamed.find(2, 5, 1));
+	}
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5, 6, 7, 8};
+	CHECK(g.begin() == g.end());
+
+	auto rng = std::mt19937(20);
+	auto node = std::uniform_int_distribution<int>(1, 10);
+	auto weight = std::uniform_int_distribution<int>(0, 2);
+	auto op = std::uniform_int_distribution<int>(0, 9);
+	for (auto step = 0; step < 2000; ++step) {
+		auto const src = node(rng);
+		auto const dst = node(rng);
+		auto const both = g.is_node(src) && g.is_node(dst);
+		switch (op(rng)) {
+		case 0: g.insert_node(src); break;
+		case 1: g.erase_node(src); break;
+		case 2:
+			if (g.is_node(src)) {
+				g.replace_node(src, dst);
+			}
+			break;
+		case 3:
+			if (both) {
+				g.merge_replace_node(src, dst);
+			}
+			break;
+		case 4:
+			if (g.begin() != g.end()) {
+				g.erase_edge(g.begin());
+			}
+			break;
+		case 5:
+			if (both) {
+				auto batch = g.batch();
+				batch.erase_edge(src, dst, 0);
+				batch.erase_edge(src, dst, 1);
+				batch.insert_edge(dst, src, weight(rng));
+				batch.commit();
+			}
+			break;
+		case 6:
+		case 7:
+			if (both) {
+				g.erase_edge(src, dst, weight(rng));
+			}
+			break;
+		default:
+			if (both) {
+				g.insert_edge(src, dst, weight(rng));
+			}
+		}
+		REQUIRE(g.begin() == expected_begin(g));
+	}
+	auto const copy = g;
+	CHECK(copy.begin() == expected_begin(copy));
+	g.clear();
+	CHECK(g.begin() == g.end());
 }
@@ -0,0 +1,118 @@
+#include "gdwg/generators.hpp"
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+/*
+    Testing Rationale & Approach
+    parse_graph is the inverse of operator<<, so most tests write a graph out and check that
+    reading it back gives an equal graph, for number and string nodes including the strings the
+    format makes awkward (empty, containing " | " or " ("), for types read through a stream, and
+    for a generated graph. Floating point weights only come back as precisely as they were
+    written, so for those the text written again must match. Text that operator<< can't have
+    written must be refused with its line, and operator>> must report the same through failbit
+    and leave the graph alone.
+*/
+
+namespace {
+	template<typename N, typename E>
+	auto text_of(gdwg::graph<N, E> const& g) -> std::string {
+		auto out = std::ostringstream();
+		out << g;
+		return out.str();
+	}
+
+	template<typename N, typename E>
+	auto round_trips(gdwg::graph<N, E> const& g) -> bool {
+		return gdwg::parse_graph<N, E>(text_of(g)) == g;
+	}
+} // namespace
+
+TEST_CASE("Parse Unit Tests") {
+	SECTION("string nodes") {
+		auto g = gdwg::graph<std::string, int>{"A", "", "B | 3", "C (", ")", "  D"};
+		g.insert_edge("A", "B | 3", -4);
+		g.insert_edge("A", "B | 3", 2);
+		g.insert_edge("B | 3", "", 0);
+		g.insert_edge("C (", ")", 1);
+		g.insert_edge(")", "C (", 1);
+		g.insert_edge("  D", "  D", 7);
+		CHECK(round_trips(g));
+		CHECK(round_trips(gdwg::graph<std::string, int>()));
+	}
+	SECTION("string weights") {
+		auto g = gdwg::graph<int, std::string>{-1, 0, 1};
+		g.insert_edge(-1, 0, "a | b");
+		g.insert_edge(-1, 0, "");
+		g.insert_edge(1, 1, " )");
+		CHECK(round_trips(g));
+	}
+	SECTION("types read through a stream") {
+		auto g = gdwg::graph<char, bool>{'a', ' ', '|'};
+		g.insert_edge('a', ' ', true);
+		g.insert_edge('|', '|', false);
+		CHECK(round_trips(g));
+	}
+	SECTION("generated graph") {
+		auto g = gdwg::graph<std::uint32_t, double>();
+		auto const generator = gdwg::rmat_generator(10, 1 << 13, 3);
+		for (auto i = std::uint32_t{0}; i < generator.node_count(); ++i) {
+			g.insert_node(i);
+		}
+		for (auto const& [src, dst, weight] : generator) {
+			g.insert_edge(static_cast<std::uint32_t>(src),
+			              static_cast<std::uint32_t>(dst),
+			              static_cast<double>(weight) / 7);
+		}
+		auto const text = text_of(g);
+		CHECK(text_of(gdwg::parse_graph<std::uint32_t, double>(text)) == text);
+	}
+	SECTION("malformed text") {
+		auto const error = [](std::string_view text) -> std::string {
+			try {
+				static_cast<void>(gdwg::parse_graph<int, int>(text));
+			} catch (std::runtime_error const& e) {
+				return e.what();
+			}
+			return "";
+		};
+		auto const line = [](int number) {
+			return "Cannot parse gdwg::graph<N, E> from text with a malformed line "
+			       + std::to_string(number);
+		};
+		CHECK(error("1 (\n  1 | 2\n)\n") == "");
+		CHECK(error("1 (\n  1 | 2\n)") == "");
+		CHECK(error("1\n") == line(1));
+		CHECK(error("x (\n)\n") == line(1));
+		CHECK(error("1 (\n 1 | 2\n)\n") == line(2));
+		CHECK(error("1 (\n  1 |2\n)\n") == line(2));
+		CHECK(error("1 (\n  1 | 2.5\n)\n") == line(2));
+		CHECK(error("1 (\n  1 | 2\n) \n") == line(3));
+		CHECK(error("1 (\n)\n2 (\n  1 | 2\n") == line(5));
+		CHECK(error("1 (\n  2 | 2\n)\n")
+		      == "Cannot parse gdwg::graph<N, E> from text with an edge to a node it doesn't "
+		         "list");
+	}
+	SECTION("operator>>") {
+		auto g = gdwg::graph<std::string, int>{"A", "B"};
+		g.insert_edge("A", "B", 5);
+		auto in = std::istringstream(text_of(g));
+		auto read = gdwg::graph<std::string, int>{"Z"};
+		CHECK(in >> read);
+		CHECK(in.eof());
+		CHECK(read == g);
+		CHECK(!(in >> read));
+		CHECK(read == g);
+
+		auto bad = std::istringstream("A (\n  C | 1\n)\n");
+		CHECK(!(bad >> read));
+		CHECK(read == g);
+
+		auto empty = std::istringstream();
+		CHECK(!(empty >> read));
+		CHECK(read == g);
+	}
+}
@@ -0,0 +1,291 @@
+#include "gdwg/snapshot.hpp"
+#include "gdwg/algorithm/bfs.hpp"
+#include "gdwg/algorithm/dijkstra.hpp"
+#include "gdwg/algorithm/pagerank.hpp"
+#include "gdwg/algorithm/scc.hpp"
+#include "gdwg/algorithm/topological_sort.hpp"
+#include "gdwg/algorithm/wcc.hpp"
+#include "gdwg/generators.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+/*
+    Testing Rationale & Approach
+    A mapped snapshot must answer every query exactly as the csr_graph it was written from, so
+    each test writes a snapshot, maps it back and compares the two through the dense id
+    interface, for number and string nodes and for a generated graph large enough to span many
+    pages. Iteration, find, connections, weights and transpose must match csr_graph's, and the
+    algorithms must give the same results on the mapping as on the csr_graph. Loading must
+    refuse files that aren't snapshots, were written for other types, or are cut short, and
+    verify must notice a changed byte that the header checks can't.
+*/
+
+namespace {
+	// A file in the temporary directory, removed when the test is done with it.
+	class temporary_file {
+	public:
+		explicit temporary_file(std::string const& name)
+		: path_(std::filesystem::temp_directory_path() / ("gdwg_snapshot_test1_" + name)) {}
+
+		temporary_file(temporary_file const&) = delete;
+		auto operator=(temporary_file const&) -> temporary_file& = delete;
+
+		~temporary_file() {
+			std::filesystem::remove(path_);
+		}
+
+		[[nodiscard]] auto path() const -> std::filesystem::path const& {
+			return path_;
+		}
+
+	private:
+		std::filesystem::path path_;
+	};
+
+	auto make_graph() -> gdwg::graph<std::string, int> {
+		auto g = gdwg::graph<std::string, int>{"A", "B", "C", "D", "E"};
+		g.insert_edge("B", "A", 3);
+		g.insert_edge("B", "C", 2);
+		g.insert_edge("B", "C", 7);
+		g.insert_edge("B", "B", -1);
+		g.insert_edge("D", "A", 4);
+		g.insert_edge("D", "E", 1);
+		return g;
+	}
+
+	template<typename N, typename E>
+	auto same_graph(gdwg::csr_graph<N, E> const& c, gdwg::mapped_graph<N, E> const& m) -> bool {
+		auto const equal = [](auto const& a, auto const& b) {
+			return std::equal(a.begin(), a.end(), b.begin(), b.end());
+		};
+		if (c.node_count() != m.node_count() || c.edge_count() != m.edge_count()
+		    || !equal(c.offsets(), m.offsets()) || !equal(c.targets(), m.targets())
+		    || !equal(c.edge_weights(), m.edge_weights()) || c.nodes() != m.nodes())
+		{
+			return false;
+		}
+		for (auto u = std::uint32_t{0}; u < c.node_count(); ++u) {
+			if (m.id(m.node(u)) != u) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Overwrites the first target with value and rewrites the checksum to match, as a buggy
+	// writer could.
+	auto set_first_target(std::filesystem::path const& path, std::uint32_t value) -> void {
+		auto bytes = std::vector<char>(std::filesystem::file_size(path));
+		auto const size = static_cast<std::streamsize>(bytes.size());
+		std::ifstream(path, std::ios::binary).read(bytes.data(), size);
+		auto header = gdwg::detail::snapshot_header();
+		std::memcpy(&header, bytes.data(), sizeof(header));
+		std::memcpy(bytes.data() + header.targets, &value, sizeof(value));
+		auto const n = header.node_count;
+		auto const m = header.edge_count;
+		auto hash = gdwg::detail::snapshot_checksum_seed;
+		auto const add = [&bytes, &hash](std::uint64_t offset, std::uint64_t length) {
+			hash = gdwg::detail::snapshot_checksum(std::as_bytes(std::span(bytes.data() + offset,
+			                                                               length)),
+			                                       hash);
+		};
+		add(header.nodes, (n + 1) * sizeof(std::uint64_t));
+		add(header.strings, header.strings_size);
+		add(header.offsets, (n + 1) * sizeof(std::uint64_t));
+		add(header.targets, m * sizeof(std::uint32_t));
+		add(header.weights, m * header.weight_size);
+		header.checksum = hash;
+		std::memcpy(bytes.data(), &header, sizeof(header));
+		std::ofstream(path, std::ios::binary).write(bytes.data(), size);
+	}
+
+	auto flip_byte(std::filesystem::path const& path, std::streamoff position) -> void {
+		auto file = std::fstream(path, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekg(position);
+		auto byte = char{};
+		file.get(byte);
+		file.seekp(position);
+		file.put(static_cast<char>(byte ^ 1));
+	}
+} // namespace
+
+TEST_CASE("Snapshot Unit Tests") {
+	SECTION("string nodes") {
+		auto const file = temporary_file("string_nodes");
+		auto const g = make_graph();
+		gdwg::write_snapshot(g, file.path());
+		auto const m = gdwg::mapped_graph<std::string, int>(file.path());
+		CHECK(m.verify());
+		CHECK(same_graph(gdwg::csr_graph(g), m));
+		CHECK(m.node(1) == "B");
+		CHECK(m.id("D") == 3);
+		CHECK(!m.id("F"));
+		CHECK(!m.is_node("AA"));
+		CHECK(m.is_connected("B", "C"));
+		CHECK(!m.is_connected("C", "B"));
+		auto const weights = m.weights_view("B", "C");
+		CHECK(std::vector<int>(weights.begin(), weights.end()) == std::vector<int>{2, 7});
+		CHECK(m.weights_view("A", "B").empty());
+		CHECK_THROWS_WITH(m.is_connected("B", "F"),
+		                  "Cannot call gdwg::mapped_graph<N, E>::is_connected if src or dst node "
+		                  "don't exist in the graph");
+	}
+	SECTION("number nodes") {
+		auto const file = temporary_file("number_nodes");
+		auto g = gdwg::graph<std::int64_t, double>{-5, 0, 7, 12};
+		g.insert_edge(-5, 12, 0.5);
+		g.insert_edge(12, -5, 1.5);
+		g.insert_edge(12, 12, -2.0);
+		gdwg::write_snapshot(g, file.path());
+		auto const m = gdwg::mapped_graph<std::int64_t, double>(file.path());
+		CHECK(m.verify());
+		CHECK(same_graph(gdwg::csr_graph(g), m));
+		CHECK(m.is_connected(12, 12));
+		CHECK(m.weights_view(12, -5).front() == 1.5);
+	}
+	SECTION("csr_graph's read interface") {
+		auto const file = temporary_file("read_interface");
+		auto const g = make_graph();
+		auto const c = gdwg::csr_graph(g);
+		gdwg::write_snapshot(g, file.path());
+		auto const m = gdwg::mapped_graph<std::string, int>(file.path());
+		auto edges = std::vector<std::tuple<std::string, std::string, int>>();
+		for (auto const& [from, to, weight] : m) {
+			edges.emplace_back(from, to, weight);
+		}
+		auto expected = std::vector<std::tuple<std::string, std::string, int>>();
+		for (auto const& [from, to, weight] : c) {
+			expected.emplace_back(from, to, weight);
+		}
+		CHECK(edges == expected);
+		auto reversed = std::vector<int>();
+		for (auto it = m.end(); it != m.begin();) {
+			reversed.push_back((*--it).weight);
+		}
+		CHECK(reversed == std::vector<int>{1, 4, 7, 2, -1, 3});
+
+		auto const edge = m.find("B", "C", 7);
+		REQUIRE(edge != m.end());
+		CHECK((*edge).from == "B");
+		CHECK((*edge).to == "C");
+		CHECK((*std::next(edge)).from == "D");
+		CHECK(m.find("B", "C", 3) == m.end());
+		CHECK(m.find("B", "F", 7) == m.end());
+		CHECK(m.connections("B") == std::vector<std::string>{"A", "B", "C"});
+		CHECK(m.connections("A").empty());
+		CHECK(m.weights("B", "C") == std::vector<int>{2, 7});
+		CHECK(m.transpose() == c.transpose());
+		CHECK_THROWS_WITH(m.connections("F"),
+		                  "Cannot call gdwg::mapped_graph<N, E>::connections if src doesn't exist "
+		                  "in the graph");
+		CHECK_THROWS_WITH(m.weights("F", "A"),
+		                  "Cannot call gdwg::mapped_graph<N, E>::weights if src or dst node don't "
+		                  "exist in the graph");
+	}
+	SECTION("algorithms run on the mapping") {
+		auto const file = temporary_file("algorithms");
+		auto const generator = gdwg::rmat_generator(10, 1 << 13, 11);
+		auto const c = gdwg::csr_graph<std::uint32_t, std::uint32_t>::from_generator(generator);
+		gdwg::write_snapshot(c, file.path());
+		auto const m = gdwg::mapped_graph<std::uint32_t, std::uint32_t>(file.path());
+		CHECK(gdwg::bfs(m, 0).distance == gdwg::bfs(c, 0).distance);
+		CHECK(gdwg::dijkstra(m, 0).distance == gdwg::dijkstra(c, 0).distance);
+		auto search = gdwg::dijkstra_search(m);
+		search.run(0);
+		CHECK(search.result().distance == gdwg::dijkstra(c, 0).distance);
+		CHECK(gdwg::tarjan_scc(m).component == gdwg::tarjan_scc(c).component);
+		CHECK(gdwg::parallel_scc(m).component == gdwg::parallel_scc(c).component);
+		CHECK(gdwg::weakly_connected_components(m).component
+		      == gdwg::weakly_connected_components(c).component);
+		CHECK(gdwg::topological_sort(m).order == gdwg::topological_sort(c).order);
+		CHECK(gdwg::find_cycle(m) == gdwg::find_cycle(c));
+		CHECK(gdwg::pagerank(m).rank == gdwg::pagerank(c).rank);
+	}
+	SECTION("empty graph") {
+		auto const file = temporary_file("empty");
+		gdwg::write_snapshot(gdwg::graph<std::string, int>(), file.path());
+		auto const m = gdwg::mapped_graph<std::string, int>(file.path());
+		CHECK(m.verify());
+		CHECK(m.empty());
+		CHECK(m.node_count() == 0);
+		CHECK(m.edge_count() == 0);
+		CHECK(!m.is_node(""));
+	}
+	SECTION("generated graph") {
+		auto const file = temporary_file("generated");
+		auto const generator = gdwg::rmat_generator(14, 1 << 17, 7);
+		auto const c = gdwg::csr_graph<std::uint32_t, std::uint32_t>::from_generator(generator);
+		gdwg::write_snapshot(c, file.path());
+		auto m = gdwg::mapped_graph<std::uint32_t, std::uint32_t>(file.path());
+		CHECK(m.verify());
+		CHECK(same_graph(c, m));
+		// a moved mapping keeps its address, so views taken before the move stay valid
+		auto const targets = m.targets();
+		auto const moved = std::move(m);
+		CHECK(moved.targets().data() == targets.data());
+		CHECK(same_graph(c, moved));
+	}
+	SECTION("rewriting replaces the snapshot") {
+		auto const file = temporary_file("rewrite");
+		auto g = make_graph();
+		gdwg::write_snapshot(g, file.path());
+		g.insert_edge("E", "A", 9);
+		gdwg::write_snapshot(g, file.path());
+		auto const m = gdwg::mapped_graph<std::string, int>(file.path());
+		CHECK(m.is_connected("E", "A"));
+		CHECK(!std::filesystem::exists(file.path().string() + ".partial"));
+	}
+	SECTION("refuses what it can't load") {
+		auto const file = temporary_file("invalid");
+		auto const load = [&file] { return gdwg::mapped_graph<std::string, int>(file.path()); };
+		CHECK_THROWS_WITH(load(),
+		                  "Cannot load gdwg::mapped_graph<N, E> from a file that can't be opened");
+
+		std::ofstream(file.path()) << "A (\n  B | 1\n)\n";
+		CHECK_THROWS_WITH(load(),
+		                  "Cannot load gdwg::mapped_graph<N, E> from a file that isn't a graph "
+		                  "snapshot");
+
+		gdwg::write_snapshot(make_graph(), file.path());
+		CHECK_THROWS_WITH((gdwg::mapped_graph<std::string, long>(file.path())),
+		                  "Cannot load gdwg::mapped_graph<N, E> from a snapshot of a different node "
+		                  "or weight type");
+		CHECK_THROWS_WITH((gdwg::mapped_graph<int, int>(file.path())),
+		                  "Cannot load gdwg::mapped_graph<N, E> from a snapshot of a different node "
+		                  "or weight type");
+
+		auto const size = std::filesystem::file_size(file.path());
+		std::filesystem::resize_file(file.path(), size - 1);
+		CHECK_THROWS_WITH(load(),
+		                  "Cannot load gdwg::mapped_graph<N, E> from a truncated or damaged "
+		                  "snapshot");
+	}
+	SECTION("verify notices damage") {
+		auto const file = temporary_file("damaged");
+		gdwg::write_snapshot(make_graph(), file.path());
+		// the last byte of the file is the last weight's
+		flip_byte(file.path(),
+		          static_cast<std::streamoff>(std::filesystem::file_size(file.path()) - 1));
+		auto const m = gdwg::mapped_graph<std::string, int>(file.path());
+		CHECK(!m.verify());
+	}
+	SECTION("verify rejects bounds a matching checksum doesn't") {
+		auto const file = temporary_file("out_of_bounds");
+		gdwg::write_snapshot(make_graph(), file.path());
+		// a target in bounds passes, so the checksum is rewritten correctly
+		set_first_target(file.path(), 0);
+		CHECK(gdwg::mapped_graph<std::string, int>(file.path()).verify());
+		set_first_target(file.path(), 5);
+		CHECK(!gdwg::mapped_graph<std::string, int>(file.path()).verify());
+	}
+}
@@ -0,0 +1,159 @@
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+/*
+    Testing Rationale & Approach
+    Every storage policy must give the same observable behaviour, apart from the node iteration
+    order of an unordered node table. Each test builds the same graph under every policy and
+    checks the results are independent of the policy, using order-insensitive checks where the
+    node table may be unordered.
+*/
+
+namespace {
+	template<typename Storage>
+	auto make_graph() -> gdwg::graph<std::string, int, Storage> {
+		auto g = gdwg::graph<std::string, int, Storage>{"A", "B", "C", "D"};
+		g.insert_edge("B", "D", 4);
+		g.insert_edge("D", "B", 4);
+		g.insert_edge("D", "B", 5);
+		g.insert_edge("D", "A", 5);
+		g.insert_edge("A", "A", 1);
+		return g;
+	}
+
+	template<typename Graph>
+	auto edge_count(Graph const& g) -> long {
+		return std::distance(g.begin(), g.end());
+	}
+} // namespace
+
+TEMPLATE_TEST_CASE("Storage Policy Unit Tests",
+                   "",
+                   gdwg::ordered_storage,
+                   gdwg::flat_storage,
+                   gdwg::hashed_storage) {
+	auto g = make_graph<TestType>();
+
+	SECTION("accessors") {
+		CHECK(g.nodes() == std::vector<std::string>{"A", "B", "C", "D"});
+		CHECK(g.is_connected("D", "B"));
+		CHECK(!g.is_connected("B", "A"));
+		CHECK(g.weights("D", "B") == std::vector<int>{4, 5});
+		auto const view = g.weights_view("D", "B");
+		CHECK(std::vector<int>(view.begin(), view.end()) == std::vector<int>{4, 5});
+		CHECK(g.connections("D") == std::vector<std::string>{"A", "B"});
+		auto const connections = g.connections_view("D");
+		CHECK(std::vector<std::string>(connections.begin(), connections.end())
+		      == std::vector<std::string>{"A", "B"});
+		CHECK(g.out_degree("D") == 3);
+		CHECK(g.distinct_out_degree("D") == 2);
+		CHECK(edge_count(g) == 5);
+	}
+	SECTION("insert_edge") {
+		CHECK(g.insert_edge("C", "A", 2));
+		CHECK(!g.insert_edge("C", "A", 2));
+		CHECK(g.insert_edge("C", "A", 1));
+		CHECK(g.weights("C", "A") == std::vector<int>{1, 2});
+		CHECK_THROWS_AS(g.insert_edge("C", "E", 1), std::runtime_error);
+	}
+	SECTION("insert_edges") {
+		auto const edges = std::vector<std::tuple<std::string, std::string, int>>{
+		   {"C", "A", 2},
+		   {"D", "B", 4},
+		   {"C", "E", 1},
+		   {"C", "A", 1},
+		};
+		CHECK(g.insert_edges(edges.begin(), edges.end(), true) == 3);
+		CHECK(g.weights("C", "A") == std::vector<int>{1, 2});
+		CHECK(g.connections("C") == std::vector<std::string>{"A", "E"});
+		CHECK(edge_count(g) == 8);
+	}
+	SECTION("batch") {
+		auto batch = g.batch();
+		batch.erase_edge("D", "B", 4);
+		batch.insert_edge("C", "B", 2);
+		batch.insert_edge("C", "A", 3);
+		batch.erase_edge("B", "D", 4);
+		batch.erase_edge("B", "D", 4);
+		CHECK(batch.commit() == std::vector<bool>{true, true, true, true, false});
+		CHECK(g.weights("D", "B") == std::vector<int>{5});
+		CHECK(g.connections("C") == std::vector<std::string>{"A", "B"});
+		CHECK(!g.is_connected("B", "D"));
+		CHECK(edge_count(g) == 5);
+	}
+	SECTION("batch erasing and inserting on one node") {
+		// inserted last, so their ids don't follow the order of their values
+		g.insert_node("E");
+		g.insert_node("0");
+		auto batch = g.batch();
+		batch.insert_edge("D", "E", 1);
+		batch.erase_edge("D", "A", 5);
+		batch.insert_edge("D", "0", 7);
+		batch.erase_edge("D", "B", 4);
+		batch.insert_edge("D", "B", 6);
+		CHECK(batch.commit() == std::vector<bool>(5, true));
+		CHECK(g.connections("D") == std::vector<std::string>{"0", "B", "E"});
+		CHECK(g.weights("D", "B") == std::vector<int>{5, 6});
+		CHECK(edge_count(g) == 6);
+		CHECK(g.erase_node("E"));
+		CHECK(g.connections("D") == std::vector<std::string>{"0", "B"});
+	}
+	SECTION("erase_edge") {
+		CHECK(g.erase_edge("D", "B", 4));
+		CHECK(!g.erase_edge("D", "B", 4));
+		CHECK(g.weights("D", "B") == std::vector<int>{5});
+		auto it = g.erase_edge(g.find("D", "A", 5));
+		REQUIRE(it != g.end());
+		CHECK((*it).from == "D");
+		CHECK((*it).to == "B");
+		CHECK((*it).weight == 5);
+		CHECK(edge_count(g) == 3);
+	}
+	SECTION("erase_edge range") {
+		auto it = g.erase_edge(g.begin(), g.end());
+		CHECK(it == g.end());
+		CHECK(edge_count(g) == 0);
+		CHECK(g.nodes().size() == 4);
+	}
+	SECTION("replace_node") {
+		CHECK(g.replace_node("D", "E"));
+		CHECK(g.nodes() == std::vector<std::string>{"A", "B", "C", "E"});
+		CHECK(g.weights("E", "B") == std::vector<int>{4, 5});
+		CHECK(g.weights("B", "E") == std::vector<int>{4});
+	}
+	SECTION("merge_replace_node") {
+		g.merge_replace_node("B", "A");
+		CHECK(g.nodes() == std::vector<std::string>{"A", "C", "D"});
+		CHECK(g.weights("A", "D") == std::vector<int>{4});
+		CHECK(g.weights("D", "A") == std::vector<int>{4, 5});
+	}
+	SECTION("erase_node") {
+		CHECK(g.erase_node("B"));
+		CHECK(g.connections("D") == std::vector<std::string>{"A"});
+		CHECK(edge_count(g) == 2);
+	}
+	SECTION("copy and compare") {
+		auto copy = g;
+		CHECK(copy == g);
+		copy.erase_edge("A", "A", 1);
+		CHECK(!(copy == g));
+	}
+	SECTION("csr_graph snapshot") {
+		auto const c = gdwg::csr_graph(g);
+		auto const expected = gdwg::csr_graph(make_graph<gdwg::ordered_storage>());
+		CHECK(c == expected);
+	}
+}
+
+TEST_CASE("Ordered Storage Output Unit Tests") {
+	auto ordered = std::ostringstream();
+	ordered << make_graph<gdwg::ordered_storage>();
+	auto flat = std::ostringstream();
+	flat << make_graph<gdwg::flat_storage>();
+	CHECK(ordered.str() == flat.str());
+}